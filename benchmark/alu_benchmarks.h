@@ -0,0 +1,120 @@
+#pragma once
+
+#include <vector>
+#include <cstdlib>
+
+#include "benchmark.h"
+#include "cpu/cpu.h"
+#include "cpu/cpu_alu_tables.h"
+
+
+const long ALU_BENCHMARK_ITERATIONS = 50000000;
+
+// Flags computed the way the ALU did before the lookup tables
+static inline uint8_t add_flags_arithmetic(uint8_t A, uint8_t n, uint8_t carry) {
+    int sum = A + n + carry;
+
+    return (((sum & 0xFF) == 0) ? ZERO_FLAG : 0)
+        | ((((A & 0xF) + (n & 0xF) + carry) > 0x0F) ? HALF_CARRY_FLAG : 0)
+        | ((sum > 0xFF) ? CARRY_FLAG : 0);
+}
+
+static inline uint8_t sub_flags_arithmetic(uint8_t A, uint8_t n, uint8_t carry) {
+    int difference = A - n - carry;
+
+    return SUBTRACT_FLAG
+        | (((difference & 0xFF) == 0) ? ZERO_FLAG : 0)
+        | ((((A & 0xF) - (n & 0xF) - carry) < 0) ? HALF_CARRY_FLAG : 0)
+        | ((difference < 0) ? CARRY_FLAG : 0);
+}
+
+static inline uint8_t inc_flags_arithmetic(uint8_t n) {
+    return ((static_cast<uint8_t>(n + 1) == 0) ? ZERO_FLAG : 0)
+        | (((n & 0xF) == 0x0F) ? HALF_CARRY_FLAG : 0);
+}
+
+static inline uint16_t daa_arithmetic(uint8_t A, uint8_t F) {
+    bool subtract = (F & SUBTRACT_FLAG) != 0;
+    bool half_carry = (F & HALF_CARRY_FLAG) != 0;
+    bool carry = (F & CARRY_FLAG) != 0;
+
+    if (subtract) {
+        if (carry) {
+            A -= 0x60;
+        }
+        if (half_carry) {
+            A -= 0x06;
+        }
+    }
+    else {
+        if (carry || A > 0x99) {
+            carry = true;
+            A += 0x60;
+        }
+        if (half_carry || (A & 0x0F) > 0x09) {
+            A += 0x06;
+        }
+    }
+
+    return (A << 8) | ((subtract) ? SUBTRACT_FLAG : 0) | ((A == 0) ? ZERO_FLAG : 0) | ((carry) ? CARRY_FLAG : 0);
+}
+
+// Compare table lookups against computing flags from the operands
+// Operands come from a pseudo random stream so the 64K entry tables see realistic cache misses,
+// the sequential streams show the best case where the same table lines are reused
+void alu_table_benchmarks() {
+    const int STREAM_SIZE = 1 << 16;
+    std::vector<uint8_t> random_operands(STREAM_SIZE * 2);
+    std::vector<uint8_t> sequential_operands(STREAM_SIZE * 2);
+
+    srand(0);
+    for (int i = 0; i < STREAM_SIZE * 2; i++) {
+        random_operands[i] = rand() & 0xFF;
+        sequential_operands[i] = (i / 64) & 0xFF;
+    }
+
+    volatile uint8_t sink8;
+    volatile uint16_t sink16;
+    size_t i = 0;
+
+    const std::vector<uint8_t> *streams[2] = {&random_operands, &sequential_operands};
+    const char *names[2] = {"random", "sequential"};
+
+    for (int s = 0; s < 2; s++) {
+        const std::vector<uint8_t> &operands = *streams[s];
+        std::string suffix = std::string(" (") + names[s] + ")";
+
+        run_benchmark("ADC flags, arithmetic" + suffix, ALU_BENCHMARK_ITERATIONS, [&]() {
+            sink8 = add_flags_arithmetic(operands[i], operands[i + 1], operands[i] & 1);
+            i = (i + 2) & (STREAM_SIZE * 2 - 2);
+        });
+        run_benchmark("ADC flags, table" + suffix, ALU_BENCHMARK_ITERATIONS, [&]() {
+            sink8 = alu_tables.add_flags(operands[i], operands[i + 1], operands[i] & 1);
+            i = (i + 2) & (STREAM_SIZE * 2 - 2);
+        });
+        run_benchmark("SBC flags, arithmetic" + suffix, ALU_BENCHMARK_ITERATIONS, [&]() {
+            sink8 = sub_flags_arithmetic(operands[i], operands[i + 1], operands[i] & 1);
+            i = (i + 2) & (STREAM_SIZE * 2 - 2);
+        });
+        run_benchmark("SBC flags, table" + suffix, ALU_BENCHMARK_ITERATIONS, [&]() {
+            sink8 = alu_tables.sub_flags(operands[i], operands[i + 1], operands[i] & 1);
+            i = (i + 2) & (STREAM_SIZE * 2 - 2);
+        });
+        run_benchmark("INC flags, arithmetic" + suffix, ALU_BENCHMARK_ITERATIONS, [&]() {
+            sink8 = inc_flags_arithmetic(operands[i]);
+            i = (i + 1) & (STREAM_SIZE * 2 - 1);
+        });
+        run_benchmark("INC flags, table" + suffix, ALU_BENCHMARK_ITERATIONS, [&]() {
+            sink8 = alu_tables.inc_flags(operands[i]);
+            i = (i + 1) & (STREAM_SIZE * 2 - 1);
+        });
+        run_benchmark("DAA, arithmetic" + suffix, ALU_BENCHMARK_ITERATIONS, [&]() {
+            sink16 = daa_arithmetic(operands[i], operands[i + 1] & 0x70);
+            i = (i + 2) & (STREAM_SIZE * 2 - 2);
+        });
+        run_benchmark("DAA, table" + suffix, ALU_BENCHMARK_ITERATIONS, [&]() {
+            sink16 = alu_tables.daa(operands[i], operands[i + 1] & 0x70);
+            i = (i + 2) & (STREAM_SIZE * 2 - 2);
+        });
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+
+
+// Run a function for a number of iterations and print the average time per iteration in nanoseconds
+template <typename Function>
+double run_benchmark(const std::string &name, long iterations, Function function) {
+    // Warm up caches and branch predictors before timing
+    for (long i = 0; i < iterations / 10; i++) {
+        function();
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; i++) {
+        function();
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+
+    std::cout << std::left << std::setw(48) << name << std::right << std::setw(10) << std::fixed << std::setprecision(2) << ns << " ns/op" << std::endl;
+
+    return ns;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+
+#include "benchmark.h"
+#include "cpu/cpu.h"
+#include "memory/memory_map.h"
+
+
+const long CPU_BENCHMARK_ITERATIONS = 20000000;
+
+// Load a program into internal RAM and point PC at it
+static void load_program(MemoryMap &mem_map, CPU &cpu, const uint8_t *program, int size) {
+    for (int i = 0; i < size; i++) {
+        mem_map.write(0xC000 + i, program[i]);
+    }
+
+    cpu.write_register(REG_PC, 0xC000);
+}
+
+// Time CPU::tick over a tight loop of common instructions, including CB prefixed opcodes and a conditional jump
+void cpu_dispatch_benchmarks() {
+    const uint8_t instruction_mix[] = {
+        0x21, 0x00, 0xD0,   // LD HL, 0xD000
+        0x06, 0x00,         // LD B, 0x00
+        0x3C,               // INC A
+        0x80,               // ADD A, B
+        0xA9,               // XOR C
+        0x57,               // LD D, A
+        0xCB, 0x32,         // SWAP D
+        0xCB, 0x7A,         // BIT 7, D
+        0x77,               // LD (HL), A
+        0x05,               // DEC B
+        0x20, 0xF4,         // JR NZ, -12
+        0xC3, 0x00, 0xC0    // JP 0xC000
+    };
+
+    MemoryMap mem_map;
+    CPU cpu(mem_map);
+    load_program(mem_map, cpu, instruction_mix, sizeof(instruction_mix));
+
+    run_benchmark("CPU::tick (instruction mix)", CPU_BENCHMARK_ITERATIONS, [&]() {
+        cpu.tick();
+    });
+
+    const uint8_t nops[] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0xC3, 0x00, 0xC0    // JP 0xC000
+    };
+
+    load_program(mem_map, cpu, nops, sizeof(nops));
+
+    run_benchmark("CPU::tick (NOP loop)", CPU_BENCHMARK_ITERATIONS, [&]() {
+        cpu.tick();
+    });
+
+    // Decode register to register loads and ALU opcodes directly, without fetching from memory
+    std::vector<uint8_t> opcodes;
+    for (int opcode = 0x40; opcode < 0xC0; opcode++) {
+        bool uses_hl = ((opcode & 0x07) == 0x06) || (opcode < 0x80 && ((opcode >> 3) & 0x07) == 0x06);
+        if (!uses_hl) {
+            opcodes.push_back(opcode);
+        }
+    }
+
+    size_t index = 0;
+    run_benchmark("CPU::decode_op (register loads and ALU)", CPU_BENCHMARK_ITERATIONS, [&]() {
+        cpu.decode_op(opcodes[index]);
+        index = (index + 1 == opcodes.size()) ? 0 : index + 1;
+    });
+}
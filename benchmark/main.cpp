@@ -0,0 +1,18 @@
+#include "cpu_benchmarks.h"
+#include "alu_benchmarks.h"
+#include "memory_benchmarks.h"
+#include "video_benchmarks.h"
+#include "rewind_benchmarks.h"
+
+
+int main(int argc, char** argv) {
+    cpu_dispatch_benchmarks();
+    alu_table_benchmarks();
+    memory_map_benchmarks();
+    video_benchmarks();
+    presenter_benchmarks();
+    tile_decoder_benchmarks();
+    rewind_benchmarks();
+
+    return 0;
+}
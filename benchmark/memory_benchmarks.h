@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+
+#include "benchmark.h"
+#include "memory/memory_map.h"
+#include "file_parser/cartridge.h"
+
+
+const long MEMORY_BENCHMARK_ITERATIONS = 50000000;
+
+// Time MemoryMap::read/write over ROM, internal RAM and high RAM
+void memory_map_benchmarks() {
+    std::vector<char> contents(2 * ROM_BANK_SIZE, 0);
+    ROMOnly cartridge(contents, 2);
+
+    MemoryMap mem_map;
+    mem_map.load_rom(&cartridge);
+
+    volatile uint8_t sink;
+    uint16_t address = 0;
+
+    run_benchmark("MemoryMap::read (ROM)", MEMORY_BENCHMARK_ITERATIONS, [&]() {
+        sink = mem_map.read(address);
+        address = (address + 1) & 0x7FFF;
+    });
+
+    address = 0;
+    run_benchmark("MemoryMap::read (internal RAM)", MEMORY_BENCHMARK_ITERATIONS, [&]() {
+        sink = mem_map.read(0xC000 + address);
+        address = (address + 1) & 0x1FFF;
+    });
+
+    address = 0;
+    run_benchmark("MemoryMap::write (internal RAM)", MEMORY_BENCHMARK_ITERATIONS, [&]() {
+        mem_map.write(0xC000 + address, address);
+        address = (address + 1) & 0x1FFF;
+    });
+
+    address = 0;
+    run_benchmark("MemoryMap::read (high RAM)", MEMORY_BENCHMARK_ITERATIONS, [&]() {
+        sink = mem_map.read(0xFF80 + address);
+        address = (address + 1) & 0x3F;
+    });
+}
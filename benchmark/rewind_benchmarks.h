@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdlib>
+#include <vector>
+
+#include "benchmark.h"
+#include "gameboy.h"
+#include "utils/rewind_buffer.h"
+
+
+const long REWIND_BENCHMARK_ITERATIONS = 2000;
+
+// Change a fraction of the framebuffer and RAM between snapshots, as a running game would
+void mutate_state(std::vector<uint8_t> &state, int percent) {
+    for (size_t i = 64; i < state.size(); i++) {
+        if (std::rand() % 100 < percent) {
+            state[i] ^= std::rand() | 1;
+        }
+    }
+}
+
+// Time one rewind capture, a full save state plus the delta against the previous
+// snapshot, and compare it to the share of a 59.73 Hz frame it costs every interval
+void rewind_benchmarks() {
+    GameBoy gb(false, true);
+    while (gb.get_frame_count() < 2) {
+        gb.tick();
+    }
+
+    std::vector<uint8_t> snapshot;
+    run_benchmark("GameBoy::save_state", REWIND_BENCHMARK_ITERATIONS, [&]() {
+        gb.save_state(snapshot);
+    });
+
+    std::srand(1);
+    const int percents[] = {1, 10, 50};
+    for (int percent : percents) {
+        RewindBuffer rewind(REWIND_MAX_SNAPSHOTS, REWIND_MAX_BYTES);
+        std::vector<uint8_t> base = gb.save_state();
+        std::vector<uint8_t> changed = base;
+        mutate_state(changed, percent);
+        bool toggle = false;
+
+        std::string name = "Rewind capture, " + std::to_string(percent) + "% changed";
+        double ns = run_benchmark(name, REWIND_BENCHMARK_ITERATIONS, [&]() {
+            gb.save_state(snapshot);
+            // Alternate between two states so every delta has the same amount of change
+            snapshot = toggle ? changed : base;
+            toggle = !toggle;
+            rewind.push(snapshot);
+        });
+
+        double frame_ns = 1e9 / GAMEBOY_FRAME_RATE;
+        std::cout << "    " << std::setprecision(3) << 100.0 * ns / REWIND_INTERVAL_FRAMES / frame_ns << "% of frame time, "
+                  << rewind.get_num_snapshots() << " snapshots in " << rewind.get_size_bytes() / 1024 << " kB" << std::endl;
+    }
+}
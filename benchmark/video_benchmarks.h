@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdlib>
+
+#include "benchmark.h"
+#include "memory/memory_map.h"
+#include "video/video.h"
+#include "video/tile_decoder.h"
+#include "user_interface/user_interface_sfml.h"
+
+
+const long VIDEO_BENCHMARK_ITERATIONS = 200000;
+const long TILE_DECODER_BENCHMARK_ITERATIONS = 20000;
+const long PRESENTER_BENCHMARK_ITERATIONS = 2000;
+
+// Time rendering single scanlines from VRAM filled with random tiles
+void video_benchmarks() {
+    MemoryMap mem_map;
+    UI_SFML ui(mem_map, true);
+    Video video(mem_map, ui, true);
+
+    std::srand(1);
+    for (int address = 0x8000; address < 0xA000; address++) {
+        mem_map.write(address, std::rand());
+    }
+
+    video.write_io_register(BGP, 0xE4);
+    video.write_io_register(LCDC, 0xF1);
+    video.write_io_register(SCX, 3);
+    video.write_io_register(WX, 7);
+
+    uint8_t line = 0;
+    run_benchmark("Video::draw_background_line", VIDEO_BENCHMARK_ITERATIONS, [&]() {
+        video.draw_background_line(line);
+        line = (line + 1) % LCD_HEIGHT;
+    });
+
+    line = 0;
+    run_benchmark("Video::draw_window_line", VIDEO_BENCHMARK_ITERATIONS, [&]() {
+        video.draw_window_line(line);
+        line = (line + 1) % LCD_HEIGHT;
+    });
+}
+
+// Time converting a full frame to RGBA and uploading it to the SFML texture, no window is opened
+void presenter_benchmarks() {
+    MemoryMap mem_map;
+    UI_SFML ui(mem_map, true);
+    FrameBuffer buffer(LCD_WIDTH, LCD_HEIGHT);
+
+    std::srand(1);
+    for (int y = 0; y < LCD_HEIGHT; y++) {
+        for (int x = 0; x < LCD_WIDTH; x++) {
+            buffer.set_pixel(x, y, (Colour_t)(std::rand() % 4));
+        }
+    }
+    buffer.set_rgba_enabled(true);
+
+    run_benchmark("FrameBuffer::update_rgba", PRESENTER_BENCHMARK_ITERATIONS, [&]() {
+        buffer.update_rgba();
+    });
+
+    // Needs an OpenGL context, skipped on machines without one
+    if (!ui.update_texture(buffer)) {
+        std::cout << "UI_SFML::update_texture skipped, no texture available" << std::endl;
+        return;
+    }
+
+    run_benchmark("UI_SFML::update_texture", PRESENTER_BENCHMARK_ITERATIONS, [&]() {
+        ui.update_texture(buffer);
+    });
+}
+
+// Decode all 384 tiles with each 2bpp decoder, against the bit by bit TileRow
+void tile_decoder_benchmarks() {
+    static uint8_t tile_data[TILE_DATA_BYTES];
+    static uint8_t pixels[NUM_TILES * TILE_HEIGHT * TILE_WIDTH];
+    const int rows = NUM_TILES * TILE_HEIGHT;
+
+    std::srand(1);
+    for (int i = 0; i < TILE_DATA_BYTES; i++) {
+        tile_data[i] = std::rand();
+    }
+
+    MemoryMap mem_map;
+    TileRow tile_row(0x8000, mem_map);
+    volatile uint8_t sink;
+
+    std::cout << "Tile decoder selected: " << get_tile_decoder_name() << std::endl;
+
+    run_benchmark("Decode 384 tiles, scalar TileRow", TILE_DECODER_BENCHMARK_ITERATIONS, [&]() {
+        for (int row = 0; row < rows; row++) {
+            std::vector<PixelColour_t> pixel_row = tile_row.get_tile_row(tile_data[2 * row], tile_data[2 * row + 1]);
+            sink = pixel_row[0];
+        }
+    });
+
+    run_benchmark("Decode 384 tiles, portable", TILE_DECODER_BENCHMARK_ITERATIONS, [&]() {
+        decode_tile_rows_portable(tile_data, pixels, rows);
+        sink = pixels[0];
+    });
+
+#ifdef TILE_DECODER_X86
+    if (cpu_supports_sse2()) {
+        run_benchmark("Decode 384 tiles, SSE2", TILE_DECODER_BENCHMARK_ITERATIONS, [&]() {
+            decode_tile_rows_sse2(tile_data, pixels, rows);
+            sink = pixels[0];
+        });
+    }
+
+    if (cpu_supports_avx2()) {
+        run_benchmark("Decode 384 tiles, AVX2", TILE_DECODER_BENCHMARK_ITERATIONS, [&]() {
+            decode_tile_rows_avx2(tile_data, pixels, rows);
+            sink = pixels[0];
+        });
+    }
+#endif
+}
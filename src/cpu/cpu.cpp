@@ -1,12 +1,17 @@
 #include "cpu.h"
+#include "cpu_alu_tables.h"
 
 
 CPU::CPU(MemoryMap &mem_map):
 m_memory_map(mem_map),
 m_halted(false),
 m_stopped(false),
-m_interrupts_enabled(true)
+m_interrupts_enabled(true),
+m_branch_taken(false),
+m_idle_loop_candidate(false),
+m_cycle_count(0)
 {
+    m_lazy_flags.operation = FLAGS_MATERIALIZED;
 
 }
 
@@ -18,2400 +23,239 @@ int CPU::tick() {
     // Handle interrupts
     this->handle_interrupts();
 
+    // With interrupts disabled a pending interrupt still ends HALT, without calling the handler
+    if (m_halted && !m_interrupts_enabled && this->interrupt_pending()) {
+        m_halted = false;
+    }
+
     // Check if halted
     int cycle_count = 4;
     if (this->is_running()) {
         // Fetch next opcode and execute
+        uint16_t pc = m_registers.read_PC();
         uint8_t opcode = this->fetch_op();
-        
-        log_cpu_no_new_line("0x%X: (0x%X)", this->read_register(REG_PC), opcode);
+
+        if (LOG_UNLIKELY(trace_logger.is_enabled())) {
+            this->trace_instruction(pc, opcode);
+        }
+
+        log_cpu_no_new_line("0x%X: (0x%X)", m_registers.read_PC(), opcode);
 
         cycle_count = this->decode_op(opcode);
     }
 
+    m_cycle_count += cycle_count;
+
     return cycle_count;
 }
 
-uint8_t CPU::fetch_op() {
-    uint16_t address = this->read_register(REG_PC);
-    this->write_register(REG_PC, address + 1);
+// Queue the state before executing the instruction at pc for the binary trace
+void CPU::trace_instruction(uint16_t pc, uint8_t opcode) {
+    TraceRecord_t record;
+    record.cycle = m_cycle_count;
+    record.pc = pc;
+    record.af = this->read_register(REG_AF);
+    record.bc = m_registers.read_register(REG_BC);
+    record.de = m_registers.read_register(REG_DE);
+    record.hl = m_registers.read_HL();
+    record.sp = m_registers.read_SP();
+    record.opcode = opcode;
+    record.operands[0] = m_memory_map.peek(pc + 1);
+    record.operands[1] = m_memory_map.peek(pc + 2);
+    record.reserved = 0;
+
+    trace_logger.record(record);
+}
 
-    return m_memory_map.read(address);
+uint64_t CPU::get_cycle_count() const {
+    return m_cycle_count;
 }
 
-int CPU::decode_op(uint8_t opcode) {
-    uint8_t arg_1;
-    uint8_t arg_2;
-    uint16_t arg16bit;
-
-    int cycle_count = 1;
-
-    switch (opcode) {
-        /****    Misc    ****/
-        // NOP
-        case 0x00:
-            
-            log_cpu("NOP" );
-            
-            cycle_count = 4;
-            break;
-        // HALT
-        case 0x76:
-            this->halt();
-            cycle_count = 4;
-            break;
-        // STOP
-        case 0x10:
-            this->stop();
-            cycle_count = 4;
-            break;
-        // DAA
-        case 0x27:
-            this->daa();
-            cycle_count = 4;
-            break;
-        // CPL
-        case 0x2F:
-            this->complement();
-            cycle_count = 4;
-            break;
-        // CCF
-        case 0x3F:
-            this->complement_carry();
-            cycle_count = 4;
-            break;
-        // SCF
-        case 0x37:
-            this->set_carry();
-            cycle_count = 4;
-            break;
-        // DI
-        case 0xF3:
-            this->disable_interrupts();
-            cycle_count = 4;
-            break;
-        // EI
-        case 0xFB:
-            this->enable_interrupts();
-            cycle_count = 4;
-            break;
-        /****    8-Bit Loads    ****/
-        // LD nn, n
-        case 0x06:
-            arg_1 = this->fetch_op();
-            this->load(REG_B, arg_1);
-            cycle_count = 4;
-            break;
-        case 0x0E:
-            arg_1 = this->fetch_op();
-            this->load(REG_C, arg_1);
-            cycle_count = 4;
-            break;
-        case 0x16:
-            arg_1 = this->fetch_op();
-            this->load(REG_D, arg_1);
-            cycle_count = 4;
-            break;
-        case 0x1E:
-            arg_1 = this->fetch_op();
-            this->load(REG_E, arg_1);
-            cycle_count = 4;
-            break;
-        case 0x26:
-            arg_1 = this->fetch_op();
-            this->load(REG_H, arg_1);
-            cycle_count = 4;
-            break;
-        case 0x2E:
-            arg_1 = this->fetch_op();
-            this->load(REG_L, arg_1);
-            cycle_count = 4;
-            break;
-        // LD r1, r2
-        case 0x7F:
-            this->load(REG_A, REG_A);
-            cycle_count = 4;
-            break;
-        case 0x78:
-            this->load(REG_A, REG_B);
-            cycle_count = 4;
-            break;
-        case 0x79:
-            this->load(REG_A, REG_C);
-            cycle_count = 4;
-            break;
-        case 0x7A:
-            this->load(REG_A, REG_D);
-            cycle_count = 4;
-            break;
-        case 0x7B:
-            this->load(REG_A, REG_E);
-            cycle_count = 4;
-            break;
-        case 0x7C:
-            this->load(REG_A, REG_H);
-            cycle_count = 4;
-            break;
-        case 0x7D:
-            this->load(REG_A, REG_L);
-            cycle_count = 4;
-            break;
-        case 0x7E:
-            this->load_from_mem(REG_A, REG_HL);
-            cycle_count = 8;
-            break;
-        case 0x40:
-            this->load(REG_B, REG_B);
-            cycle_count = 4;
-            break;
-        case 0x41:
-            this->load(REG_B, REG_C);
-            cycle_count = 4;
-            break;
-        case 0x42:
-            this->load(REG_B, REG_D);
-            cycle_count = 4;
-            break;
-        case 0x43:
-            this->load(REG_B, REG_E);
-            cycle_count = 4;
-            break;
-        case 0x44:
-            this->load(REG_B, REG_H);
-            cycle_count = 4;
-            break;
-        case 0x45:
-            this->load(REG_B, REG_L);
-            cycle_count = 4;
-            break;
-        case 0x46:
-            this->load_from_mem(REG_B, REG_HL);
-            cycle_count = 8;
-            break;
-        case 0x48:
-            this->load(REG_C, REG_B);
-            cycle_count = 4;
-            break;
-        case 0x49:
-            this->load(REG_C, REG_C);
-            cycle_count = 4;
-            break;
-        case 0x4A:
-            this->load(REG_C, REG_D);
-            cycle_count = 4;
-            break;
-        case 0x4B:
-            this->load(REG_C, REG_E);
-            cycle_count = 4;
-            break;
-        case 0x4C:
-            this->load(REG_C, REG_H);
-            cycle_count = 4;
-            break;
-        case 0x4D:
-            this->load(REG_C, REG_L);
-            cycle_count = 4;
-            break;
-        case 0x4E:
-            this->load_from_mem(REG_C, REG_HL);
-            cycle_count = 8;
-            break;
-        case 0x50:
-            this->load(REG_D, REG_B);
-            cycle_count = 4;
-            break;
-        case 0x51:
-            this->load(REG_D, REG_C);
-            cycle_count = 4;
-            break;
-        case 0x52:
-            this->load(REG_D, REG_D);
-            cycle_count = 4;
-            break;
-        case 0x53:
-            this->load(REG_D, REG_E);
-            cycle_count = 4;
-            break;
-        case 0x54:
-            this->load(REG_D, REG_H);
-            cycle_count = 4;
-            break;
-        case 0x55:
-            this->load(REG_D, REG_L);
-            cycle_count = 4;
-            break;
-        case 0x56:
-            this->load_from_mem(REG_D, REG_HL);
-            cycle_count = 8;
-            break;
-        case 0x58:
-            this->load(REG_E, REG_B);
-            cycle_count = 4;
-            break;
-        case 0x59:
-            this->load(REG_E, REG_C);
-            cycle_count = 4;
-            break;
-        case 0x5A:
-            this->load(REG_E, REG_D);
-            cycle_count = 4;
-            break;
-        case 0x5B:
-            this->load(REG_E, REG_E);
-            cycle_count = 4;
-            break;
-        case 0x5C:
-            this->load(REG_E, REG_H);
-            cycle_count = 4;
-            break;
-        case 0x5D:
-            this->load(REG_E, REG_L);
-            cycle_count = 4;
-            break;
-        case 0x5E:
-            this->load_from_mem(REG_E, REG_HL);
-            cycle_count = 8;
-            break;
-        case 0x60:
-            this->load(REG_H, REG_B);
-            cycle_count = 4;
-            break;
-        case 0x61:
-            this->load(REG_H, REG_C);
-            cycle_count = 4;
-            break;
-        case 0x62:
-            this->load(REG_H, REG_D);
-            cycle_count = 4;
-            break;
-        case 0x63:
-            this->load(REG_H, REG_E);
-            cycle_count = 4;
-            break;
-        case 0x64:
-            this->load(REG_H, REG_H);
-            cycle_count = 4;
-            break;
-        case 0x65:
-            this->load(REG_H, REG_L);
-            cycle_count = 4;
-            break;
-        case 0x66:
-            this->load_from_mem(REG_H, REG_HL);
-            cycle_count = 8;
-            break;
-        case 0x68:
-            this->load(REG_L, REG_B);
-            cycle_count = 4;
-            break;
-        case 0x69:
-            this->load(REG_L, REG_C);
-            cycle_count = 4;
-            break;
-        case 0x6A:
-            this->load(REG_L, REG_D);
-            cycle_count = 4;
-            break;
-        case 0x6B:
-            this->load(REG_L, REG_E);
-            cycle_count = 4;
-            break;
-        case 0x6C:
-            this->load(REG_L, REG_H);
-            cycle_count = 4;
-            break;
-        case 0x6D:
-            this->load(REG_L, REG_L);
-            cycle_count = 4;
-            break;
-        case 0x6E:
-            this->load_from_mem(REG_L, REG_HL);
-            cycle_count = 8;
-            break;
-        case 0x70:
-            this->load_to_mem(REG_HL, REG_B);
-            cycle_count = 8;
-            break;
-        case 0x71:
-            this->load_to_mem(REG_HL, REG_C);
-            cycle_count = 8;
-            break;
-        case 0x72:
-            this->load_to_mem(REG_HL, REG_D);
-            cycle_count = 8;
-            break;
-        case 0x73:
-            this->load_to_mem(REG_HL, REG_E);
-            cycle_count = 8;
-            break;
-        case 0x74:
-            this->load_to_mem(REG_HL, REG_H);
-            cycle_count = 8;
-            break;
-        case 0x75:
-            this->load_to_mem(REG_HL, REG_L);
-            cycle_count = 8;
-            break;
-        case 0x36:
-            arg_1 = this->fetch_op();
-            this->load_to_mem(REG_HL, arg_1);
-            cycle_count = 12;
-            break;
-        // LD A, n
-        case 0x0A:
-            this->load_from_mem(REG_A, REG_BC);
-            cycle_count = 8;
-            break;
-        case 0x1A:
-            this->load_from_mem(REG_A, REG_DE);
-            cycle_count = 8;
-            break;
-        case 0xFA:
-            arg_1 = this->fetch_op();
-            arg_2 = this->fetch_op();
-            arg16bit = (arg_2 << 8) | arg_1;
+// Pending lazy flags are written to F first, so F is always part of the state
+void CPU::save_state(StateWriter &writer) {
+    this->materialize_flags();
 
-            this->load_from_mem(REG_A, arg16bit);
-            cycle_count = 16;
-            break;
-        case 0x3E:
-            arg_1 = this->fetch_op();
-            this->load(REG_A, arg_1);
-            cycle_count = 8;
-            break;
-        // LD n, A
-        case 0x47:
-            this->load(REG_B, REG_A);
-            cycle_count = 4;
-            break;
-        case 0x4F:
-            this->load(REG_C, REG_A);
-            cycle_count = 4;
-            break;
-        case 0x57:
-            this->load(REG_D, REG_A);
-            cycle_count = 4;
-            break;
-        case 0x5F:
-            this->load(REG_E, REG_A);
-            cycle_count = 4;
-            break;
-        case 0x67:
-            this->load(REG_H, REG_A);
-            cycle_count = 4;
-            break;
-        case 0x6F:
-            this->load(REG_L, REG_A);
-            cycle_count = 4;
-            break;
-        case 0x02:
-            this->load_to_mem(REG_BC, REG_A);
-            cycle_count = 8;
-            break;
-        case 0x12:
-            this->load_to_mem(REG_DE, REG_A);
-            cycle_count = 8;
-            break;
-        case 0x77:
-            this->load_to_mem(REG_HL, REG_A);
-            cycle_count = 8;
-            break;
-        case 0xEA:
-            arg_1 = this->fetch_op();
-            arg_2 = this->fetch_op();
-            arg16bit = (arg_2 << 8) | arg_1;
+    m_registers.save_state(writer);
+    writer.write(m_halted);
+    writer.write(m_stopped);
+    writer.write(m_interrupts_enabled);
+    writer.write(m_cycle_count);
+}
 
-            this->load_to_mem(arg16bit, REG_A);
-            cycle_count = 16;
-            break;
-        // LD A, (C)
-        case 0xF2:
-            arg16bit = 0xFF00 + this->read_register(REG_C);
-            this->load_from_mem(REG_A, arg16bit);
-            cycle_count = 8;
-            break;
-        // LD (C), A
-        case 0xE2:
-            arg16bit = 0xFF00 + this->read_register(REG_C);
-            this->load_to_mem(arg16bit, REG_A);
-            cycle_count = 8;
-            break;
-        // LDD A, (HL)
-        case 0x3A:
-            this->load_from_mem(REG_A, REG_HL);
-            this->alu_dec_16bit(REG_HL);
-            cycle_count = 8;
-            break;
-        // LDD (HL), A
-        case 0x32:
-            this->load_to_mem(REG_HL, REG_A);
-            this->alu_dec_16bit(REG_HL);
-            cycle_count = 8;
-            break;
-        // LDI A, (HL)
-        case 0x2A:
-            this->load_from_mem(REG_A, REG_HL);
-            this->alu_inc_16bit(REG_HL);
-            cycle_count = 8;
-            break;
-        // LDI (HL), A
-        case 0x22:
-            this->load_to_mem(REG_HL, REG_A);
-            this->alu_inc_16bit(REG_HL);
-            cycle_count = 8;
-            break;
-        // LDH (n), A
-        case 0xE0:
-            arg16bit = 0xFF00 + this->fetch_op();
-            this->load_to_mem(arg16bit, REG_A);
-            cycle_count = 12;
-            break;
-        // LDH A, (n)
-        case 0xF0:
-            arg16bit = 0xFF00 + this->fetch_op();
-            this->load_from_mem(REG_A, arg16bit);
-            cycle_count = 12;
-            break;
-        /****    16-Bit Loads    ****/
-        // LD n, nn
-        case 0x01:
-            arg_1 = this->fetch_op();
-            arg_2 = this->fetch_op();
-            arg16bit = (arg_2 << 8) | arg_1;
-
-            this->load(REG_BC, arg16bit);
-            cycle_count = 12;
-            break;
-        case 0x11:
-            arg_1 = this->fetch_op();
-            arg_2 = this->fetch_op();
-            arg16bit = (arg_2 << 8) | arg_1;
+void CPU::load_state(StateReader &reader) {
+    m_registers.load_state(reader);
+    reader.read(m_halted);
+    reader.read(m_stopped);
+    reader.read(m_interrupts_enabled);
+    reader.read(m_cycle_count);
 
-            this->load(REG_DE, arg16bit);
-            cycle_count = 12;
-            break;
-        case 0x21:
-            arg_1 = this->fetch_op();
-            arg_2 = this->fetch_op();
-            arg16bit = (arg_2 << 8) | arg_1;
+    m_lazy_flags.operation = FLAGS_MATERIALIZED;
+    m_branch_taken = false;
+    m_idle_loop_candidate = false;
+}
 
-            this->load(REG_HL, arg16bit);
-            cycle_count = 12;
-            break;
-        case 0x31:
-            arg_1 = this->fetch_op();
-            arg_2 = this->fetch_op();
-            arg16bit = (arg_2 << 8) | arg_1;
+uint64_t CPU::fast_forward(uint64_t cycles_to_deadline) {
+    if (!m_halted && !m_idle_loop_candidate) {
+        return 0;
+    }
 
-            this->load(REG_SP, arg16bit);
-            cycle_count = 12;
-            break;
-        // LD SP, HL
-        case 0xF9:
-            this->load(REG_SP, REG_HL);
-            cycle_count = 8;
-            break;
-        // LDHL SP, n
-        case 0xF8:
-            arg_1 = this->fetch_op();
+    // Every instruction goes to the trace, and anything pending is handled on the next tick
+    if (m_stopped || LOG_UNLIKELY(trace_logger.is_enabled()) || this->interrupt_pending()) {
+        return 0;
+    }
 
-            this->load_HL(arg_1);
-            cycle_count = 12;
-            break;
-        // LD (nn), SP
-        case 0x08:
-            arg_1 = this->fetch_op();
-            arg_2 = this->fetch_op();
-            arg16bit = (arg_2 << 8) | arg_1;
-
-            this->load_to_mem16bit(arg16bit, REG_SP);            
-            cycle_count = 20;
-            break;
-        // PUSH nn
-        case 0xF5:
-            log_cpu("PUSH AF");
+    // Nothing would wake it up, keep running instructions instead
+    if (cycles_to_deadline == NO_EVENT) {
+        return 0;
+    }
 
-            this->push_stack(REG_AF);
-            cycle_count = 16;
-            break;
-        case 0xC5:
-            log_cpu("PUSH BC");
+    // One skip never goes past what the scheduler adds at once
+    cycles_to_deadline = std::min<uint64_t>(cycles_to_deadline, INT_MAX / 4 * 4);
 
-            this->push_stack(REG_BC);
-            cycle_count = 16;
-            break;
-        case 0xD5:
-            log_cpu("PUSH DE");
+    uint64_t skipped = 0;
+    if (m_halted) {
+        // A halted tick is 4 cycles, run them all up to the first one reaching the deadline
+        skipped = (cycles_to_deadline + 3) / 4 * 4;
+    }
+    else {
+        // Only whole passes that end before the deadline, the rest runs normally
+        int loop_cycles = this->get_idle_loop_cycles();
+        if (loop_cycles > 0) {
+            skipped = cycles_to_deadline / loop_cycles * loop_cycles;
+        }
+    }
 
-            this->push_stack(REG_DE);
-            cycle_count = 16;
-            break;
-        case 0xE5:
-            log_cpu("PUSH HL");
+    m_cycle_count += skipped;
 
-            this->push_stack(REG_HL);
-            cycle_count = 16;
-            break;
-        // POP nn
-        case 0xF1:
-            log_cpu("POP AF");
+    return skipped;
+}
 
-            this->pop_stack(REG_AF);
-            cycle_count = 12;
-            break;
-        case 0xC1:
-            log_cpu("POP BC");
+bool CPU::interrupt_pending() {
+    return (this->read_io_register(IE) & this->read_io_register(IF) & 0x1F) != 0;
+}
 
-            this->pop_stack(REG_BC);
-            cycle_count = 12;
-            break;
-        case 0xD1:
-            log_cpu("POP DE");
+// Cycles of one pass through a loop at PC that reads memory, tests it and jumps back,
+// if another pass would leave every register unchanged. 0 if PC is not at such a loop.
+int CPU::get_idle_loop_cycles() {
+    uint16_t pc = m_registers.read_PC();
+    uint16_t address = pc;
+    int cycles = 0;
+
+    // Load
+    uint16_t load_address;
+    uint8_t opcode = m_memory_map.read(address);
+    if (opcode == 0xF0) {
+        // LDH A, (n)
+        load_address = 0xFF00 + m_memory_map.read(address + 1);
+        cycles += 12;
+        address += 2;
+    }
+    else if (opcode == 0xFA) {
+        // LD A, (nn)
+        load_address = m_memory_map.read(address + 1) | (m_memory_map.read(address + 2) << 8);
+        cycles += 16;
+        address += 3;
+    }
+    else {
+        return 0;
+    }
 
-            this->pop_stack(REG_DE);
-            cycle_count = 12;
-            break;
-        case 0xE1:
-            log_cpu("POP HL");
+    if (!is_idle_loop_address(load_address)) {
+        return 0;
+    }
 
-            this->pop_stack(REG_HL);
-            cycle_count = 12;
-            break;
-        /****    8-Bit ALU    ****/
-        // ADD A, n
-        case 0x87:
-            this->alu_add(REG_A, false);
-            cycle_count = 4;
-            break;
-        case 0x80:
-            this->alu_add(REG_B, false);
-            cycle_count = 4;
-            break;
-        case 0x81:
-            this->alu_add(REG_C, false);
-            cycle_count = 4;
-            break;
-        case 0x82:
-            this->alu_add(REG_D, false);
-            cycle_count = 4;
-            break;
-        case 0x83:
-            this->alu_add(REG_E, false);
-            cycle_count = 4;
-            break;
-        case 0x84:
-            this->alu_add(REG_H, false);
-            cycle_count = 4;
-            break;
-        case 0x85:
-            this->alu_add(REG_L, false);
-            cycle_count = 4;
-            break;
-        case 0x86:
-            this->alu_add(REG_HL, false);
-            cycle_count = 8;
-            break;
-        case 0xC6:
-            arg_1 = this->fetch_op();
-            this->alu_add(arg_1, false);
-            cycle_count = 8;
-            break;
-        // ADC A, n
-        case 0x8F:
-            this->alu_add(REG_A, true);
-            cycle_count = 4;
-            break;
-        case 0x88:
-            this->alu_add(REG_B, true);
-            cycle_count = 4;
-            break;
-        case 0x89:
-            this->alu_add(REG_C, true);
-            cycle_count = 4;
-            break;
-        case 0x8A:
-            this->alu_add(REG_D, true);
-            cycle_count = 4;
-            break;
-        case 0x8B:
-            this->alu_add(REG_E, true);
-            cycle_count = 4;
-            break;
-        case 0x8C:
-            this->alu_add(REG_H, true);
-            cycle_count = 4;
-            break;
-        case 0x8D:
-            this->alu_add(REG_L, true);
-            cycle_count = 4;
-            break;
-        case 0x8E:
-            this->alu_add(REG_HL, true);
-            cycle_count = 8;
-            break;
-        case 0xCE:
-            arg_1 = this->fetch_op();
-            this->alu_add(arg_1, true);
-            cycle_count = 8;
-            break;
-        // SUB n
-        case 0x97:
-            this->alu_sub(REG_A, false);
-            cycle_count = 4;
-            break;
-        case 0x90:
-            this->alu_sub(REG_B, false);
-            cycle_count = 4;
-            break;
-        case 0x91:
-            this->alu_sub(REG_C, false);
-            cycle_count = 4;
-            break;
-        case 0x92:
-            this->alu_sub(REG_D, false);
-            cycle_count = 4;
-            break;
-        case 0x93:
-            this->alu_sub(REG_E, false);
-            cycle_count = 4;
-            break;
-        case 0x94:
-            this->alu_sub(REG_H, false);
-            cycle_count = 4;
-            break;
-        case 0x95:
-            this->alu_sub(REG_L, false);
-            cycle_count = 4;
-            break;
-        case 0x96:
-            this->alu_sub(REG_HL, false);
-            cycle_count = 8;
-            break;
-        case 0xD6:
-            arg_1 = this->fetch_op();
-            this->alu_sub(arg_1, false);
-            cycle_count = 8;
-            break;
-        // SBC n
-        case 0x9F:
-            this->alu_sub(REG_A, true);
-            cycle_count = 4;
-            break;
-        case 0x98:
-            this->alu_sub(REG_B, true);
-            cycle_count = 4;
-            break;
-        case 0x99:
-            this->alu_sub(REG_C, true);
-            cycle_count = 4;
-            break;
-        case 0x9A:
-            this->alu_sub(REG_D, true);
-            cycle_count = 4;
-            break;
-        case 0x9B:
-            this->alu_sub(REG_E, true);
-            cycle_count = 4;
-            break;
-        case 0x9C:
-            this->alu_sub(REG_H, true);
-            cycle_count = 4;
-            break;
-        case 0x9D:
-            this->alu_sub(REG_L, true);
-            cycle_count = 4;
-            break;
-        case 0x9E:
-            this->alu_sub(REG_HL, true);
-            cycle_count = 8;
-            break;
-        case 0xDE:
-            arg_1 = this->fetch_op();
-            this->alu_sub(arg_1, true);
-            cycle_count = 8;
-            break;
-        // AND n
-        case 0xA7:
-            this->alu_and(REG_A);
-            cycle_count = 4;
-            break;
-        case 0xA0:
-            this->alu_and(REG_B);
-            cycle_count = 4;
-            break;
-        case 0xA1:
-            this->alu_and(REG_C);
-            cycle_count = 4;
-            break;
-        case 0xA2:
-            this->alu_and(REG_D);
-            cycle_count = 4;
-            break;
-        case 0xA3:
-            this->alu_and(REG_E);
-            cycle_count = 4;
-            break;
-        case 0xA4:
-            this->alu_and(REG_H);
-            cycle_count = 4;
-            break;
-        case 0xA5:
-            this->alu_and(REG_L);
-            cycle_count = 4;
-            break;
-        case 0xA6:
-            this->alu_and(REG_HL);
-            cycle_count = 8;
-            break;
-        case 0xE6:
-            arg_1 = this->fetch_op();
-            this->alu_and(arg_1);
-            cycle_count = 8;
-            break;
-        // OR n
-        case 0xB7:
-            this->alu_or(REG_A);
-            cycle_count = 4;
-            break;
-        case 0xB0:
-            this->alu_or(REG_B);
-            cycle_count = 4;
-            break;
-        case 0xB1:
-            this->alu_or(REG_C);
-            cycle_count = 4;
-            break;
-        case 0xB2:
-            this->alu_or(REG_D);
-            cycle_count = 4;
-            break;
-        case 0xB3:
-            this->alu_or(REG_E);
-            cycle_count = 4;
-            break;
-        case 0xB4:
-            this->alu_or(REG_H);
-            cycle_count = 4;
-            break;
-        case 0xB5:
-            this->alu_or(REG_L);
-            cycle_count = 4;
-            break;
-        case 0xB6:
-            this->alu_or(REG_HL);
-            cycle_count = 8;
-            break;
-        case 0xF6:
-            arg_1 = this->fetch_op();
-            this->alu_or(arg_1);
-            cycle_count = 8;
-            break;
-        // XOR n
-        case 0xAF:
-            this->alu_xor(REG_A);
-            cycle_count = 4;
-            break;
-        case 0xA8:
-            this->alu_xor(REG_B);
-            cycle_count = 4;
-            break;
-        case 0xA9:
-            this->alu_xor(REG_C);
-            cycle_count = 4;
-            break;
-        case 0xAA:
-            this->alu_xor(REG_D);
-            cycle_count = 4;
-            break;
-        case 0xAB:
-            this->alu_xor(REG_E);
-            cycle_count = 4;
-            break;
-        case 0xAC:
-            this->alu_xor(REG_H);
-            cycle_count = 4;
-            break;
-        case 0xAD:
-            this->alu_xor(REG_L);
-            cycle_count = 4;
-            break;
-        case 0xAE:
-            this->alu_xor(REG_HL);
-            cycle_count = 8;
-            break;
-        case 0xEE:
-            arg_1 = this->fetch_op();
-            this->alu_xor(arg_1);
-            cycle_count = 8;
-            break;
+    // Test, gives A and the Z and C flags
+    uint8_t value = m_memory_map.read(load_address);
+    uint8_t a = value;
+    bool zero;
+    bool carry;
+    opcode = m_memory_map.read(address);
+    if (opcode == 0xFE) {
         // CP n
-        case 0xBF:
-            this->alu_cp(REG_A);
-            cycle_count = 4;
-            break;
-        case 0xB8:
-            this->alu_cp(REG_B);
-            cycle_count = 4;
-            break;
-        case 0xB9:
-            this->alu_cp(REG_C);
-            cycle_count = 4;
-            break;
-        case 0xBA:
-            this->alu_cp(REG_D);
-            cycle_count = 4;
-            break;
-        case 0xBB:
-            this->alu_cp(REG_E);
-            cycle_count = 4;
-            break;
-        case 0xBC:
-            this->alu_cp(REG_H);
-            cycle_count = 4;
-            break;
-        case 0xBD:
-            this->alu_cp(REG_L);
-            cycle_count = 4;
-            break;
-        case 0xBE:
-            this->alu_cp(REG_HL);
-            cycle_count = 8;
-            break;
-        case 0xFE:
-            arg_1 = this->fetch_op();
-            this->alu_cp(arg_1);
-            cycle_count = 8;
-            break;
-        // INC n
-        case 0x3C:
-            this->alu_inc(REG_A);
-            cycle_count = 4;
-            break;
-        case 0x04:
-            this->alu_inc(REG_B);
-            cycle_count = 4;
-            break;
-        case 0x0C:
-            this->alu_inc(REG_C);
-            cycle_count = 4;
-            break;
-        case 0x14:
-            this->alu_inc(REG_D);
-            cycle_count = 4;
-            break;
-        case 0x1C:
-            this->alu_inc(REG_E);
-            cycle_count = 4;
-            break;
-        case 0x24:
-            this->alu_inc(REG_H);
-            cycle_count = 4;
-            break;
-        case 0x2C:
-            this->alu_inc(REG_L);
-            cycle_count = 4;
-            break;
-        case 0x34:
-            this->alu_inc(REG_HL);
-            cycle_count = 12;
-            break;
-        // DEC n
-        case 0x3D:
-            this->alu_dec(REG_A);
-            cycle_count = 4;
-            break;
-        case 0x05:
-            this->alu_dec(REG_B);
-            cycle_count = 4;
-            break;
-        case 0x0D:
-            this->alu_dec(REG_C);
-            cycle_count = 4;
-            break;
-        case 0x15:
-            this->alu_dec(REG_D);
-            cycle_count = 4;
-            break;
-        case 0x1D:
-            this->alu_dec(REG_E);
-            cycle_count = 4;
-            break;
-        case 0x25:
-            this->alu_dec(REG_H);
-            cycle_count = 4;
-            break;
-        case 0x2D:
-            this->alu_dec(REG_L);
-            cycle_count = 4;
-            break;
-        case 0x35:
-            this->alu_dec(REG_HL);
-            cycle_count = 12;
-            break;
-        /****    16-Bit Arithmetic    ****/
-        // ADD HL, n
-        case 0x09:
-            this->alu_add_HL(REG_BC);
-            cycle_count = 8;
-            break;
-        case 0x19:
-            this->alu_add_HL(REG_DE);
-            cycle_count = 8;
-            break;
-        case 0x29:
-            this->alu_add_HL(REG_HL);
-            cycle_count = 8;
-            break;
-        case 0x39:
-            this->alu_add_HL(REG_SP);
-            cycle_count = 8;
-            break;
-        // ADD SP, n
-        case 0xE8:
-            arg_1 = this->fetch_op();
-            this->alu_add_SP(arg_1);
-            cycle_count = 16;
-            break;
-        // INC nn
-        case 0x03:
-            this->alu_inc_16bit(REG_BC);
-            cycle_count = 8;
-            break;
-        case 0x13:
-            this->alu_inc_16bit(REG_DE);
-            cycle_count = 8;
-            break;
-        case 0x23:
-            this->alu_inc_16bit(REG_HL);
-            cycle_count = 8;
-            break;
-        case 0x33:
-            this->alu_inc_16bit(REG_SP);
-            cycle_count = 8;
-            break;
-        // DEC nn
-        case 0x0B:
-            this->alu_dec_16bit(REG_BC);
-            cycle_count = 8;
-            break;
-        case 0x1B:
-            this->alu_dec_16bit(REG_DE);
-            cycle_count = 8;
-            break;
-        case 0x2B:
-            this->alu_dec_16bit(REG_HL);
-            cycle_count = 8;
-            break;
-        case 0x3B:
-            this->alu_dec_16bit(REG_SP);
-            cycle_count = 8;
-            break;
-        /****    Rotates and Shifts    ****/
-        // RLCA
-        case 0x07:
-            this->rotate_left_A(false);
-            cycle_count = 4;
-            break;
-        // RLA
-        case 0x17:
-            this->rotate_left_A(true);
-            cycle_count = 4;
-            break;
-        // RRCA
-        case 0x0F:
-            this->rotate_right_A(false);
-            cycle_count = 4;
-            break;
-        // RRA
-        case 0x1F:
-            this->rotate_right_A(true);
-            cycle_count = 4;
-            break;
-        /****    Jumps    ****/
-        // JP nn
-        case 0xC3:
-            // LSB
-            arg_1 = this->fetch_op();
-            // MSB
-            arg_2 = this->fetch_op();
-            arg16bit = (arg_2 << 8) | arg_1;
-
-            
-            log_cpu("JP %X", arg16bit);
-            
-
-            this->jump(arg16bit);
-            cycle_count = 12;
-            break;
-        // JP cc, nn
-        case 0xC2:
-            // LSB
-            arg_1 = this->fetch_op();
-            // MSB
-            arg_2 = this->fetch_op();
-            arg16bit = (arg_2 << 8) | arg_1;
-
-            
-            log_cpu("JP NZ %X", arg16bit);
-            
-
-            this->jump_conditional(arg16bit, ZERO_FLAG, false);
-            cycle_count = 12;
-            break;
-        case 0xCA:
-            // LSB
-            arg_1 = this->fetch_op();
-            // MSB
-            arg_2 = this->fetch_op();
-            arg16bit = (arg_2 << 8) | arg_1;
-
-            
-            log_cpu("JP Z %X", arg16bit);
-            
-
-            this->jump_conditional(arg16bit, ZERO_FLAG, true);
-            cycle_count = 12;
-            break;
-        case 0xD2:
-            // LSB
-            arg_1 = this->fetch_op();
-            // MSB
-            arg_2 = this->fetch_op();
-            arg16bit = (arg_2 << 8) | arg_1;
-
-            
-            log_cpu("JP NC %X", arg16bit);
-            
-
-            this->jump_conditional(arg16bit, CARRY_FLAG, false);
-            cycle_count = 12;
-            break;
-        case 0xDA:
-            // LSB
-            arg_1 = this->fetch_op();
-            // MSB
-            arg_2 = this->fetch_op();
-            arg16bit = (arg_2 << 8) | arg_1;
-
-            
-            log_cpu("JP C %X", arg16bit);
-            
-
-            this->jump_conditional(arg16bit, CARRY_FLAG, true);
-            cycle_count = 12;
-            break;
-        // JP HL
-        case 0xE9:
-            
-            log_cpu("JP (%X)", this->read_register(REG_HL));
-            
-
-            this->jump_hl();
-            cycle_count = 4;
-            break;
-        // JR n
-        case 0x18:
-            arg_1 = this->fetch_op();
-
-            
-            log_cpu("JR %d", static_cast<int8_t>(arg_1));
-            
-
-            this->jump_add(arg_1);
-            cycle_count = 8;
-            break;
-        // JR cc, n
-        case 0x20:
-            arg_1 = this->fetch_op();
-            
-            log_cpu("JR NZ %d", static_cast<int8_t>(arg_1));
-            
-
-            this->jump_add_conditional(arg_1, ZERO_FLAG, false);
-            cycle_count = 8;
-            break;
-        case 0x28:
-            arg_1 = this->fetch_op();
-            
-            log_cpu("JR Z %d", static_cast<int8_t>(arg_1));
-            
-
-            this->jump_add_conditional(arg_1, ZERO_FLAG, true);
-            cycle_count = 8;
-            break;
-        case 0x30:
-            arg_1 = this->fetch_op();
-            
-            log_cpu("JR NC %d", static_cast<int8_t>(arg_1));
-            
-
-            this->jump_add_conditional(arg_1, CARRY_FLAG, false);
-            cycle_count = 8;
-            break;
-        case 0x38:
-            arg_1 = this->fetch_op();
-            
-            log_cpu("JR C %d", static_cast<int8_t>(arg_1));
-            
-
-            this->jump_add_conditional(arg_1, CARRY_FLAG, true);
-            cycle_count = 8;
-            break;
-        /****    Calls    ****/
-        // CALL nn
-        case 0xCD:
-            arg_1 = this->fetch_op();
-            arg_2 = this->fetch_op();
-            arg16bit = (arg_2 << 8) | arg_1;
-
-            
-            log_cpu("CALL %X", arg16bit);
-            
-
-            this->call(arg16bit);
-            cycle_count = 12;
-            break;
-        // CALL cc, nn
-        case 0xC4:
-            arg_1 = this->fetch_op();
-            arg_2 = this->fetch_op();
-            arg16bit = (arg_2 << 8) | arg_1;
-
-            
-            log_cpu("CALL NZ %X", arg16bit);
-            
-
-            this->call(arg16bit, ZERO_FLAG, false);
-            cycle_count = 12;
-            break;
-        case 0xCC:
-            arg_1 = this->fetch_op();
-            arg_2 = this->fetch_op();
-            arg16bit = (arg_2 << 8) | arg_1;
-
-            
-            log_cpu("CALL Z %X", arg16bit);
-            
-
-            this->call(arg16bit, ZERO_FLAG, true);
-            cycle_count = 12;
-            break;
-        case 0xD4:
-            arg_1 = this->fetch_op();
-            arg_2 = this->fetch_op();
-            arg16bit = (arg_2 << 8) | arg_1;
-
-            
-            log_cpu("CALL NC %X", arg16bit);
-            
-
-            this->call(arg16bit, CARRY_FLAG, false);
-            cycle_count = 12;
-            break;
-        case 0xDC:
-            arg_1 = this->fetch_op();
-            arg_2 = this->fetch_op();
-            arg16bit = (arg_2 << 8) | arg_1;
-
-            
-            log_cpu("CALL C %X", arg16bit);
-            
-
-            this->call(arg16bit, CARRY_FLAG, true);
-            cycle_count = 12;
-            break;
-        /****    Restarts    ****/
-        // RST n
-        case 0xC7:
-            
-            log_cpu("RST 00");
-            
-
-            this->restart(0x00);
-            cycle_count = 32;
-            break;
-        case 0xCF:
-            
-            log_cpu("RST 08");
-            
-
-            this->restart(0x08);
-            cycle_count = 32;
-            break;
-        case 0xD7:
-            
-            log_cpu("RST 10");
-            
-
-            this->restart(0x10);
-            cycle_count = 32;
-            break;
-        case 0xDF:
-            
-            log_cpu("RST 18");
-            
-
-            this->restart(0x18);
-            cycle_count = 32;
-            break;
-        case 0xE7:
-            
-            log_cpu("RST 20");
-            
+        uint8_t n = m_memory_map.read(address + 1);
+        zero = (value == n);
+        carry = (value < n);
+        cycles += 8;
+        address += 2;
+    }
+    else if (opcode == 0xE6) {
+        // AND n
+        a = value & m_memory_map.read(address + 1);
+        zero = (a == 0);
+        carry = false;
+        cycles += 8;
+        address += 2;
+    }
+    else if (opcode == 0xA7 || opcode == 0xB7) {
+        // AND A, OR A
+        zero = (value == 0);
+        carry = false;
+        cycles += 4;
+        address += 1;
+    }
+    else {
+        return 0;
+    }
 
-            this->restart(0x20);
-            cycle_count = 32;
-            break;
-        case 0xEF:
-            
-            log_cpu("RST 28");
-            
+    // JR cc back to the load
+    opcode = m_memory_map.read(address);
+    if (opcode != 0x20 && opcode != 0x28 && opcode != 0x30 && opcode != 0x38) {
+        return 0;
+    }
 
-            this->restart(0x28);
-            cycle_count = 32;
-            break;
-        case 0xF7:
-            
-            log_cpu("RST 30");
-            
+    int8_t offset = static_cast<int8_t>(m_memory_map.read(address + 1));
+    if ((uint16_t)(address + 2 + offset) != pc) {
+        return 0;
+    }
 
-            this->restart(0x30);
-            cycle_count = 32;
-            break;
-        case 0xFF:
-            
-            log_cpu("RST 38");
-            
+    bool flag = (opcode & 0x10) ? carry : zero;
+    bool jump_if_set = (opcode & 0x08) != 0;
+    if (flag != jump_if_set) {
+        return 0;
+    }
 
-            this->restart(0x38);
-            cycle_count = 32;
-            break;
-        /****    Returns    ****/
-        // RET
-        case 0xC9:
-            log_cpu("RET");
+    // The pass that just ran must have read the same value, otherwise the registers still change
+    if (a != m_registers.read_register(REG_A) || zero != this->read_flag_register(ZERO_FLAG) || carry != this->read_flag_register(CARRY_FLAG)) {
+        return 0;
+    }
 
-            this->ret();
-            cycle_count = 8;
-            break;
-        // RET cc
-        case 0xC0:
-            log_cpu("RET NZ");
+    return cycles + 12;
+}
 
-            this->ret(ZERO_FLAG, false);
-            cycle_count = 8;
-            break;
-        case 0xC8:
-            log_cpu("RET Z");
+// Memory that only changes when the CPU writes it or a scheduled event runs
+bool CPU::is_idle_loop_address(uint16_t address) {
+    if (address >= 0xC000 && address < 0xE000) {
+        return true;
+    }
 
-            this->ret(ZERO_FLAG, true);
-            cycle_count = 8;
-            break;
-        case 0xD0:
-            log_cpu("RET NC");
+    if (address >= 0xFF80 && address < 0xFFFF) {
+        return true;
+    }
 
-            this->ret(CARRY_FLAG, false);
-            cycle_count = 8;
-            break;
-        case 0xD8:
-            log_cpu("RET C");
+    return address == LY || address == STAT || address == IF;
+}
 
-            this->ret(CARRY_FLAG, true);
-            cycle_count = 8;
-            break;
-        // RETI
-        case 0xD9:
-            log_cpu("RETI");
+uint8_t CPU::fetch_op() {
+    uint16_t address = m_registers.read_PC();
+    m_registers.write_PC(address + 1);
 
-            this->ret_enable_interrupts();
-            cycle_count = 8;
-            break;
-        
-        // CB
-        case 0xCB:
-            opcode = this->fetch_op();
-
-            switch (opcode) {
-                /****    Misc    ****/
-                // SWAP n
-                case 0x37:
-                    this->swap(REG_A);
-                    cycle_count = 8;
-                    break;
-                case 0x30:
-                    this->swap(REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0x31:
-                    this->swap(REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0x32:
-                    this->swap(REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0x33:
-                    this->swap(REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0x34:
-                    this->swap(REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0x35:
-                    this->swap(REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0x36:
-                    this->swap(REG_HL);
-                    cycle_count = 16;
-                    break;
-                /****    Rotates and Shifts    ****/
-                // RLC n
-                case 0x07:
-                    this->rotate_left(REG_A, false, true);
-                    cycle_count = 8;
-                    break;
-                case 0x00:
-                    this->rotate_left(REG_B, false, true);
-                    cycle_count = 8;
-                    break;
-                case 0x01:
-                    this->rotate_left(REG_C, false, true);
-                    cycle_count = 8;
-                    break;
-                case 0x02:
-                    this->rotate_left(REG_D, false, true);
-                    cycle_count = 8;
-                    break;
-                case 0x03:
-                    this->rotate_left(REG_E, false, true);
-                    cycle_count = 8;
-                    break;
-                case 0x04:
-                    this->rotate_left(REG_H, false, true);
-                    cycle_count = 8;
-                    break;
-                case 0x05:
-                    this->rotate_left(REG_L, false, true);
-                    cycle_count = 8;
-                    break;
-                case 0x06:
-                    this->rotate_left(REG_HL, false, true);
-                    cycle_count = 16;
-                    break;
-                // RL n
-                case 0x17:
-                    this->rotate_left(REG_A, true, true);
-                    cycle_count = 8;
-                    break;
-                case 0x10:
-                    this->rotate_left(REG_B, true, true);
-                    cycle_count = 8;
-                    break;
-                case 0x11:
-                    this->rotate_left(REG_C, true, true);
-                    cycle_count = 8;
-                    break;
-                case 0x12:
-                    this->rotate_left(REG_D, true, true);
-                    cycle_count = 8;
-                    break;
-                case 0x13:
-                    this->rotate_left(REG_E, true, true);
-                    cycle_count = 8;
-                    break;
-                case 0x14:
-                    this->rotate_left(REG_H, true, true);
-                    cycle_count = 8;
-                    break;
-                case 0x15:
-                    this->rotate_left(REG_L, true, true);
-                    cycle_count = 8;
-                    break;
-                case 0x16:
-                    this->rotate_left(REG_HL, true, true);
-                    cycle_count = 16;
-                    break;
-                // RRC n
-                case 0x0F:
-                    this->rotate_right(REG_A, false, true);
-                    cycle_count = 8;
-                    break;
-                case 0x08:
-                    this->rotate_right(REG_B, false, true);
-                    cycle_count = 8;
-                    break;
-                case 0x09:
-                    this->rotate_right(REG_C, false, true);
-                    cycle_count = 8;
-                    break;
-                case 0x0A:
-                    this->rotate_right(REG_D, false, true);
-                    cycle_count = 8;
-                    break;
-                case 0x0B:
-                    this->rotate_right(REG_E, false, true);
-                    cycle_count = 8;
-                    break;
-                case 0x0C:
-                    this->rotate_right(REG_H, false, true);
-                    cycle_count = 8;
-                    break;
-                case 0x0D:
-                    this->rotate_right(REG_L, false, true);
-                    cycle_count = 8;
-                    break;
-                case 0x0E:
-                    this->rotate_right(REG_HL, false, true);
-                    cycle_count = 16;
-                    break;
-                // RR n
-                case 0x1F:
-                    this->rotate_right(REG_A, true, true);
-                    cycle_count = 8;
-                    break;
-                case 0x18:
-                    this->rotate_right(REG_B, true, true);
-                    cycle_count = 8;
-                    break;
-                case 0x19:
-                    this->rotate_right(REG_C, true, true);
-                    cycle_count = 8;
-                    break;
-                case 0x1A:
-                    this->rotate_right(REG_D, true, true);
-                    cycle_count = 8;
-                    break;
-                case 0x1B:
-                    this->rotate_right(REG_E, true, true);
-                    cycle_count = 8;
-                    break;
-                case 0x1C:
-                    this->rotate_right(REG_H, true, true);
-                    cycle_count = 8;
-                    break;
-                case 0x1D:
-                    this->rotate_right(REG_L, true, true);
-                    cycle_count = 8;
-                    break;
-                case 0x1E:
-                    this->rotate_right(REG_HL, true, true);
-                    cycle_count = 16;
-                    break;
-                // SLA n
-                case 0x27:
-                    this->shift_left(REG_A);
-                    cycle_count = 8;
-                    break;
-                case 0x20:
-                    this->shift_left(REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0x21:
-                    this->shift_left(REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0x22:
-                    this->shift_left(REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0x23:
-                    this->shift_left(REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0x24:
-                    this->shift_left(REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0x25:
-                    this->shift_left(REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0x26:
-                    this->shift_left(REG_HL);
-                    cycle_count = 16;
-                    break;
-                // SRA n
-                case 0x2F:
-                    this->shift_right(REG_A, true);
-                    cycle_count = 8;
-                    break;
-                case 0x28:
-                    this->shift_right(REG_B, true);
-                    cycle_count = 8;
-                    break;
-                case 0x29:
-                    this->shift_right(REG_C, true);
-                    cycle_count = 8;
-                    break;
-                case 0x2A:
-                    this->shift_right(REG_D, true);
-                    cycle_count = 8;
-                    break;
-                case 0x2B:
-                    this->shift_right(REG_E, true);
-                    cycle_count = 8;
-                    break;
-                case 0x2C:
-                    this->shift_right(REG_H, true);
-                    cycle_count = 8;
-                    break;
-                case 0x2D:
-                    this->shift_right(REG_L, true);
-                    cycle_count = 8;
-                    break;
-                case 0x2E:
-                    this->shift_right(REG_HL, true);
-                    cycle_count = 16;
-                    break;
-                // SRL n
-                case 0x3F:
-                    this->shift_right(REG_A, false);
-                    cycle_count = 8;
-                    break;
-                case 0x38:
-                    this->shift_right(REG_B, false);
-                    cycle_count = 8;
-                    break;
-                case 0x39:
-                    this->shift_right(REG_C, false);
-                    cycle_count = 8;
-                    break;
-                case 0x3A:
-                    this->shift_right(REG_D, false);
-                    cycle_count = 8;
-                    break;
-                case 0x3B:
-                    this->shift_right(REG_E, false);
-                    cycle_count = 8;
-                    break;
-                case 0x3C:
-                    this->shift_right(REG_H, false);
-                    cycle_count = 8;
-                    break;
-                case 0x3D:
-                    this->shift_right(REG_L, false);
-                    cycle_count = 8;
-                    break;
-                case 0x3E:
-                    this->shift_right(REG_HL, false);
-                    cycle_count = 16;
-                    break;
-                /****    Bit Opcodes    ****/
-                // BIT 0, r
-                case 0x40:
-                    this->test_bit(0, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0x41:
-                    this->test_bit(0, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0x42:
-                    this->test_bit(0, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0x43:
-                    this->test_bit(0, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0x44:
-                    this->test_bit(0, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0x45:
-                    this->test_bit(0, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0x46:
-                    this->test_bit(0, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0x47:
-                    this->test_bit(0, REG_A);
-                    cycle_count = 8;
-                    break;
-                // BIT 1, r
-                case 0x48:
-                    this->test_bit(1, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0x49:
-                    this->test_bit(1, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0x4A:
-                    this->test_bit(1, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0x4B:
-                    this->test_bit(1, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0x4C:
-                    this->test_bit(1, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0x4D:
-                    this->test_bit(1, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0x4E:
-                    this->test_bit(1, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0x4F:
-                    this->test_bit(1, REG_A);
-                    cycle_count = 8;
-                    break;
-                // BIT 2, r
-                case 0x50:
-                    this->test_bit(2, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0x51:
-                    this->test_bit(2, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0x52:
-                    this->test_bit(2, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0x53:
-                    this->test_bit(2, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0x54:
-                    this->test_bit(2, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0x55:
-                    this->test_bit(2, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0x56:
-                    this->test_bit(2, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0x57:
-                    this->test_bit(2, REG_A);
-                    cycle_count = 8;
-                    break;
-                // BIT 3, r
-                case 0x58:
-                    this->test_bit(3, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0x59:
-                    this->test_bit(3, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0x5A:
-                    this->test_bit(3, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0x5B:
-                    this->test_bit(3, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0x5C:
-                    this->test_bit(3, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0x5D:
-                    this->test_bit(3, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0x5E:
-                    this->test_bit(3, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0x5F:
-                    this->test_bit(3, REG_A);
-                    cycle_count = 8;
-                    break;
-                // BIT 4, r
-                case 0x60:
-                    this->test_bit(4, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0x61:
-                    this->test_bit(4, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0x62:
-                    this->test_bit(4, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0x63:
-                    this->test_bit(4, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0x64:
-                    this->test_bit(4, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0x65:
-                    this->test_bit(4, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0x66:
-                    this->test_bit(4, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0x67:
-                    this->test_bit(4, REG_A);
-                    cycle_count = 8;
-                    break;
-                // BIT 5, r
-                case 0x68:
-                    this->test_bit(5, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0x69:
-                    this->test_bit(5, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0x6A:
-                    this->test_bit(5, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0x6B:
-                    this->test_bit(5, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0x6C:
-                    this->test_bit(5, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0x6D:
-                    this->test_bit(5, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0x6E:
-                    this->test_bit(5, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0x6F:
-                    this->test_bit(5, REG_A);
-                    cycle_count = 8;
-                    break;
-                // BIT 6, r
-                case 0x70:
-                    this->test_bit(6, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0x71:
-                    this->test_bit(6, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0x72:
-                    this->test_bit(6, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0x73:
-                    this->test_bit(6, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0x74:
-                    this->test_bit(6, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0x75:
-                    this->test_bit(6, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0x76:
-                    this->test_bit(6, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0x77:
-                    this->test_bit(6, REG_A);
-                    cycle_count = 8;
-                    break;
-                // BIT 7, r
-                case 0x78:
-                    this->test_bit(7, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0x79:
-                    this->test_bit(7, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0x7A:
-                    this->test_bit(7, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0x7B:
-                    this->test_bit(7, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0x7C:
-                    this->test_bit(7, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0x7D:
-                    this->test_bit(7, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0x7E:
-                    this->test_bit(7, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0x7F:
-                    this->test_bit(7, REG_A);
-                    cycle_count = 8;
-                    break;
-                // SET 0, r
-                case 0xC0:
-                    this->set_bit(0, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0xC1:
-                    this->set_bit(0, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0xC2:
-                    this->set_bit(0, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0xC3:
-                    this->set_bit(0, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0xC4:
-                    this->set_bit(0, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0xC5:
-                    this->set_bit(0, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0xC6:
-                    this->set_bit(0, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0xC7:
-                    this->set_bit(0, REG_A);
-                    cycle_count = 8;
-                    break;
-                // SET 1, r
-                case 0xC8:
-                    this->set_bit(1, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0xC9:
-                    this->set_bit(1, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0xCA:
-                    this->set_bit(1, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0xCB:
-                    this->set_bit(1, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0xCC:
-                    this->set_bit(1, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0xCD:
-                    this->set_bit(1, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0xCE:
-                    this->set_bit(1, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0xCF:
-                    this->set_bit(1, REG_A);
-                    cycle_count = 8;
-                    break;
-                // SET 2, r
-                case 0xD0:
-                    this->set_bit(2, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0xD1:
-                    this->set_bit(2, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0xD2:
-                    this->set_bit(2, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0xD3:
-                    this->set_bit(2, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0xD4:
-                    this->set_bit(2, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0xD5:
-                    this->set_bit(2, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0xD6:
-                    this->set_bit(2, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0xD7:
-                    this->set_bit(2, REG_A);
-                    cycle_count = 8;
-                    break;
-                // SET 3, r
-                case 0xD8:
-                    this->set_bit(3, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0xD9:
-                    this->set_bit(3, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0xDA:
-                    this->set_bit(3, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0xDB:
-                    this->set_bit(3, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0xDC:
-                    this->set_bit(3, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0xDD:
-                    this->set_bit(3, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0xDE:
-                    this->set_bit(3, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0xDF:
-                    this->set_bit(3, REG_A);
-                    cycle_count = 8;
-                    break;
-                // SET 4, r
-                case 0xE0:
-                    this->set_bit(4, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0xE1:
-                    this->set_bit(4, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0xE2:
-                    this->set_bit(4, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0xE3:
-                    this->set_bit(4, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0xE4:
-                    this->set_bit(4, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0xE5:
-                    this->set_bit(4, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0xE6:
-                    this->set_bit(4, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0xE7:
-                    this->set_bit(4, REG_A);
-                    cycle_count = 8;
-                    break;
-                // SET 5, r
-                case 0xE8:
-                    this->set_bit(5, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0xE9:
-                    this->set_bit(5, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0xEA:
-                    this->set_bit(5, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0xEB:
-                    this->set_bit(5, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0xEC:
-                    this->set_bit(5, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0xED:
-                    this->set_bit(5, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0xEE:
-                    this->set_bit(5, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0xEF:
-                    this->set_bit(5, REG_A);
-                    cycle_count = 8;
-                    break;
-                // SET 6, r
-                case 0xF0:
-                    this->set_bit(6, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0xF1:
-                    this->set_bit(6, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0xF2:
-                    this->set_bit(6, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0xF3:
-                    this->set_bit(6, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0xF4:
-                    this->set_bit(6, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0xF5:
-                    this->set_bit(6, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0xF6:
-                    this->set_bit(6, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0xF7:
-                    this->set_bit(6, REG_A);
-                    cycle_count = 8;
-                    break;
-                // SET 7, r
-                case 0xF8:
-                    this->set_bit(7, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0xF9:
-                    this->set_bit(7, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0xFA:
-                    this->set_bit(7, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0xFB:
-                    this->set_bit(7, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0xFC:
-                    this->set_bit(7, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0xFD:
-                    this->set_bit(7, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0xFE:
-                    this->set_bit(7, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0xFF:
-                    this->set_bit(7, REG_A);
-                    cycle_count = 8;
-                    break;
-                // RES 0, r
-                case 0x80:
-                    this->reset_bit(0, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0x81:
-                    this->reset_bit(0, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0x82:
-                    this->reset_bit(0, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0x83:
-                    this->reset_bit(0, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0x84:
-                    this->reset_bit(0, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0x85:
-                    this->reset_bit(0, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0x86:
-                    this->reset_bit(0, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0x87:
-                    this->reset_bit(0, REG_A);
-                    cycle_count = 8;
-                    break;
-                // RES 1, r
-                case 0x88:
-                    this->reset_bit(1, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0x89:
-                    this->reset_bit(1, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0x8A:
-                    this->reset_bit(1, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0x8B:
-                    this->reset_bit(1, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0x8C:
-                    this->reset_bit(1, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0x8D:
-                    this->reset_bit(1, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0x8E:
-                    this->reset_bit(1, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0x8F:
-                    this->reset_bit(1, REG_A);
-                    cycle_count = 8;
-                    break;
-                // RES 2, r
-                case 0x90:
-                    this->reset_bit(2, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0x91:
-                    this->reset_bit(2, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0x92:
-                    this->reset_bit(2, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0x93:
-                    this->reset_bit(2, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0x94:
-                    this->reset_bit(2, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0x95:
-                    this->reset_bit(2, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0x96:
-                    this->reset_bit(2, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0x97:
-                    this->reset_bit(2, REG_A);
-                    cycle_count = 8;
-                    break;
-                // RES 3, r
-                case 0x98:
-                    this->reset_bit(3, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0x99:
-                    this->reset_bit(3, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0x9A:
-                    this->reset_bit(3, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0x9B:
-                    this->reset_bit(3, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0x9C:
-                    this->reset_bit(3, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0x9D:
-                    this->reset_bit(3, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0x9E:
-                    this->reset_bit(3, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0x9F:
-                    this->reset_bit(3, REG_A);
-                    cycle_count = 8;
-                    break;
-                // RES 4, r
-                case 0xA0:
-                    this->reset_bit(4, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0xA1:
-                    this->reset_bit(4, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0xA2:
-                    this->reset_bit(4, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0xA3:
-                    this->reset_bit(4, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0xA4:
-                    this->reset_bit(4, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0xA5:
-                    this->reset_bit(4, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0xA6:
-                    this->reset_bit(4, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0xA7:
-                    this->reset_bit(4, REG_A);
-                    cycle_count = 8;
-                    break;
-                // RES 5, r
-                case 0xA8:
-                    this->reset_bit(5, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0xA9:
-                    this->reset_bit(5, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0xAA:
-                    this->reset_bit(5, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0xAB:
-                    this->reset_bit(5, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0xAC:
-                    this->reset_bit(5, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0xAD:
-                    this->reset_bit(5, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0xAE:
-                    this->reset_bit(5, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0xAF:
-                    this->reset_bit(5, REG_A);
-                    cycle_count = 8;
-                    break;
-                // RES 6, r
-                case 0xB0:
-                    this->reset_bit(6, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0xB1:
-                    this->reset_bit(6, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0xB2:
-                    this->reset_bit(6, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0xB3:
-                    this->reset_bit(6, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0xB4:
-                    this->reset_bit(6, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0xB5:
-                    this->reset_bit(6, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0xB6:
-                    this->reset_bit(6, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0xB7:
-                    this->reset_bit(6, REG_A);
-                    cycle_count = 8;
-                    break;
-                // RES 7, r
-                case 0xB8:
-                    this->reset_bit(7, REG_B);
-                    cycle_count = 8;
-                    break;
-                case 0xB9:
-                    this->reset_bit(7, REG_C);
-                    cycle_count = 8;
-                    break;
-                case 0xBA:
-                    this->reset_bit(7, REG_D);
-                    cycle_count = 8;
-                    break;
-                case 0xBB:
-                    this->reset_bit(7, REG_E);
-                    cycle_count = 8;
-                    break;
-                case 0xBC:
-                    this->reset_bit(7, REG_H);
-                    cycle_count = 8;
-                    break;
-                case 0xBD:
-                    this->reset_bit(7, REG_L);
-                    cycle_count = 8;
-                    break;
-                case 0xBE:
-                    this->reset_bit(7, REG_HL);
-                    cycle_count = 16;
-                    break;
-                case 0xBF:
-                    this->reset_bit(7, REG_A);
-                    cycle_count = 8;
-                    break;
-                // Default, opcode not implemented
-                default:
-                    std::cerr << "CB opcode " << static_cast<int>(opcode) << " not implemented" << std::endl;
-            }
+    return m_memory_map.read(address);
+}
 
-            break;
+int CPU::decode_op(uint8_t opcode) {
+    const Instruction_t *instruction = &s_instruction_table[opcode];
 
-        // Default, opcode not implemented
-        default:
-            std::cerr << "Opcode " << static_cast<int>(opcode) << " not implemented" << std::endl;
+    // Prefixed opcodes are looked up in the CB table
+    if (opcode == 0xCB) {
+        opcode = this->fetch_op();
+        instruction = &s_cb_instruction_table[opcode];
     }
 
-    return cycle_count;
-}
-
-void CPU::write_register(Registers_t reg, uint16_t data) {
-    m_registers.write_register(reg, data);
-}
+    m_branch_taken = false;
+    m_idle_loop_candidate = false;
+    (this->*(instruction->handler))(opcode);
 
-uint16_t CPU::read_register(Registers_t reg) {
-    return m_registers.read_register(reg);
+    return (m_branch_taken) ? instruction->branch_cycles : instruction->cycles;
 }
 
 void CPU::write_memory(uint8_t data) {
@@ -2433,25 +277,68 @@ uint8_t CPU::read_memory(Registers_t reg) {
 }
 
 void CPU::set_flag_register(CPUFlag_t flag, bool value) {
-    uint8_t flag_register_val = this->read_register(REG_F);
+    this->materialize_flags();
+
     uint8_t val = (value) ? flag : 0;
 
-    // Reset flag value to 0
-    flag_register_val &= ~flag;
-    this->write_register(REG_F, flag_register_val);
-    // Set new flag value
-    flag_register_val |= val;
-    this->write_register(REG_F, flag_register_val);
+    // Reset flag value to 0 and set new flag value
+    m_registers.write_F((m_registers.read_F() & ~flag) | val);
 }
 
 bool CPU::read_flag_register(CPUFlag_t flag) {
-    return (this->read_register(REG_F) & flag) == flag;
+    this->materialize_flags();
+
+    return (m_registers.read_F() & flag) == flag;
 }
 
 void CPU::reset_flag_register() {
     this->write_register(REG_F, 0);
 }
 
+// Compute Z/N/H/C from the last recorded ALU operation and store them in F
+void CPU::materialize_flags() {
+    const LazyFlags_t &lazy = m_lazy_flags;
+    if (lazy.operation == FLAGS_MATERIALIZED) {
+        return;
+    }
+
+    uint8_t flags;
+
+    switch (lazy.operation) {
+        case FLAGS_ADD:
+#ifdef ALU_FLAG_TABLES
+            flags = alu_tables.add_flags(lazy.operand_1, lazy.operand_2, lazy.carry);
+#else
+            flags = ((lazy.result == 0) ? ZERO_FLAG : 0)
+                | ((((lazy.operand_1 & 0xF) + (lazy.operand_2 & 0xF) + lazy.carry) > 0x0F) ? HALF_CARRY_FLAG : 0)
+                | (((lazy.operand_1 + lazy.operand_2 + lazy.carry) > 0xFF) ? CARRY_FLAG : 0);
+#endif
+            break;
+        case FLAGS_SUB:
+#ifdef ALU_FLAG_TABLES
+            flags = alu_tables.sub_flags(lazy.operand_1, lazy.operand_2, lazy.carry);
+#else
+            flags = SUBTRACT_FLAG
+                | ((lazy.result == 0) ? ZERO_FLAG : 0)
+                | (((lazy.operand_1 & 0xF) < ((lazy.operand_2 & 0xF) + lazy.carry)) ? HALF_CARRY_FLAG : 0)
+                | ((lazy.operand_1 < (lazy.operand_2 + lazy.carry)) ? CARRY_FLAG : 0);
+#endif
+            break;
+        case FLAGS_INC:
+            flags = alu_tables.inc_flags(lazy.operand_1) | lazy.carry;
+            break;
+        case FLAGS_DEC:
+            flags = alu_tables.dec_flags(lazy.operand_1) | lazy.carry;
+            break;
+        default:
+            flags = ((lazy.result == 0) ? ZERO_FLAG : 0) | lazy.carry;
+            break;
+    }
+
+    m_registers.write_F(flags);
+    m_lazy_flags.operation = FLAGS_MATERIALIZED;
+}
+
 uint8_t CPU::read_io_register(IORegisters_t reg) {
     return m_memory_map.read((uint16_t)reg);
 }
@@ -3,11 +3,14 @@
 #include <iostream>
 #include <exception>
 #include <chrono>
+#include <climits>
 
 #include "cpu_registers.h"
 #include "../memory/memory_map.h"
 #include "../memory/mem_io.h"
 #include "../debugger/logger.h"
+#include "../debugger/trace_logger.h"
+#include "../scheduler/scheduler.h"
 
 
 typedef enum CPUFlag {
@@ -25,6 +28,40 @@ typedef enum InteruptVector {
     JOYPAD_ISR = 0x60
 } InterruptVector_t;
 
+// Longest polling loop recognised by fast_forward: LD A, (nn); CP n; JR cc, e
+const int MAX_IDLE_LOOP_BYTES = 7;
+
+// Operation that last set the flags, Z/N/H/C are only computed when F is read
+typedef enum FlagOperation {
+    FLAGS_MATERIALIZED,
+    FLAGS_ADD,
+    FLAGS_SUB,
+    FLAGS_INC,
+    FLAGS_DEC,
+    FLAGS_ZERO
+} FlagOperation_t;
+
+typedef struct LazyFlags {
+    FlagOperation_t operation;
+    uint8_t operand_1;
+    uint8_t operand_2;
+    // Carry in for ADD and SUB, known flag bits for INC, DEC and ZERO
+    uint8_t carry;
+    uint8_t result;
+} LazyFlags_t;
+
+class CPU;
+
+typedef void (CPU::*OpcodeHandler_t)(uint8_t);
+
+// Entry in the opcode dispatch tables, cycles are given in clock cycles
+typedef struct Instruction {
+    OpcodeHandler_t handler;
+    int cycles;
+    // Cycle count used when a conditional jump, call or return is taken
+    int branch_cycles;
+} Instruction_t;
+
 class CPU {
     public:
         CPU(MemoryMap &);
@@ -61,6 +98,17 @@ class CPU {
         bool is_running() const;
         bool interrupts_enabled() const;
 
+        // Clock cycles executed since the CPU was created
+        uint64_t get_cycle_count() const;
+
+        // Skip whole cycles of HALT or of a polling loop that cannot change before the deadline,
+        // returns the clock cycles skipped. Nothing is skipped when the deadline is NO_EVENT.
+        uint64_t fast_forward(uint64_t);
+
+        // Registers, HALT/STOP/IME and the cycle count
+        void save_state(StateWriter &);
+        void load_state(StateReader &);
+
     private:
         CPURegisters m_registers;
         MemoryMap &m_memory_map;
@@ -68,6 +116,125 @@ class CPU {
         bool m_halted;
         bool m_stopped;
         bool m_interrupts_enabled;
+        bool m_branch_taken;
+        // Set by a short backward JR, the CPU may be at the start of a polling loop
+        bool m_idle_loop_candidate;
+        uint64_t m_cycle_count;
+
+        LazyFlags_t m_lazy_flags;
+
+        void trace_instruction(uint16_t, uint8_t);
+
+        bool interrupt_pending();
+        int get_idle_loop_cycles();
+        static bool is_idle_loop_address(uint16_t);
+
+        void set_lazy_flags(FlagOperation_t, uint8_t, uint8_t, uint8_t, uint8_t);
+        void materialize_flags();
+        bool carry_flag() const;
+
+        static const Instruction_t s_instruction_table[256];
+        static const Instruction_t s_cb_instruction_table[256];
+
+        uint16_t fetch_op_16bit();
+
+        /****    Opcode Handlers    ****/
+        // Misc.
+        void op_nop(uint8_t);
+        void op_stop(uint8_t);
+        void op_halt(uint8_t);
+        void op_daa(uint8_t);
+        void op_cpl(uint8_t);
+        void op_ccf(uint8_t);
+        void op_scf(uint8_t);
+        void op_di(uint8_t);
+        void op_ei(uint8_t);
+        void op_undefined(uint8_t);
+
+        // 8-Bit Loads
+        void op_ld_r_r(uint8_t);
+        void op_ld_r_n(uint8_t);
+        void op_ld_r_hl(uint8_t);
+        void op_ld_hl_r(uint8_t);
+        void op_ld_hl_n(uint8_t);
+        void op_ld_a_rr(uint8_t);
+        void op_ld_rr_a(uint8_t);
+        void op_ld_a_nn(uint8_t);
+        void op_ld_nn_a(uint8_t);
+        void op_ld_a_c(uint8_t);
+        void op_ld_c_a(uint8_t);
+        void op_ldd_a_hl(uint8_t);
+        void op_ldd_hl_a(uint8_t);
+        void op_ldi_a_hl(uint8_t);
+        void op_ldi_hl_a(uint8_t);
+        void op_ldh_n_a(uint8_t);
+        void op_ldh_a_n(uint8_t);
+
+        // 16-Bit Loads
+        void op_ld_rr_nn(uint8_t);
+        void op_ld_sp_hl(uint8_t);
+        void op_ld_hl_sp_e(uint8_t);
+        void op_ld_nn_sp(uint8_t);
+        void op_push(uint8_t);
+        void op_pop(uint8_t);
+
+        // 8-Bit ALU
+        void op_add_r(uint8_t);
+        void op_add_n(uint8_t);
+        void op_adc_r(uint8_t);
+        void op_adc_n(uint8_t);
+        void op_sub_r(uint8_t);
+        void op_sub_n(uint8_t);
+        void op_sbc_r(uint8_t);
+        void op_sbc_n(uint8_t);
+        void op_and_r(uint8_t);
+        void op_and_n(uint8_t);
+        void op_or_r(uint8_t);
+        void op_or_n(uint8_t);
+        void op_xor_r(uint8_t);
+        void op_xor_n(uint8_t);
+        void op_cp_r(uint8_t);
+        void op_cp_n(uint8_t);
+        void op_inc_r(uint8_t);
+        void op_dec_r(uint8_t);
+
+        // 16-Bit ALU
+        void op_add_hl_rr(uint8_t);
+        void op_add_sp_e(uint8_t);
+        void op_inc_rr(uint8_t);
+        void op_dec_rr(uint8_t);
+
+        // Rotates and Shifts
+        void op_rlca(uint8_t);
+        void op_rla(uint8_t);
+        void op_rrca(uint8_t);
+        void op_rra(uint8_t);
+        void op_rlc(uint8_t);
+        void op_rl(uint8_t);
+        void op_rrc(uint8_t);
+        void op_rr(uint8_t);
+        void op_sla(uint8_t);
+        void op_sra(uint8_t);
+        void op_srl(uint8_t);
+        void op_swap(uint8_t);
+
+        // Bit Opcodes
+        void op_bit(uint8_t);
+        void op_set(uint8_t);
+        void op_res(uint8_t);
+
+        // Jumps, Calls, Restarts and Returns
+        void op_jp(uint8_t);
+        void op_jp_cc(uint8_t);
+        void op_jp_hl(uint8_t);
+        void op_jr(uint8_t);
+        void op_jr_cc(uint8_t);
+        void op_call(uint8_t);
+        void op_call_cc(uint8_t);
+        void op_rst(uint8_t);
+        void op_ret(uint8_t);
+        void op_ret_cc(uint8_t);
+        void op_reti(uint8_t);
 
         /****    8-Bit and 16-Bit Loads    ****/
         void load(Registers_t, Registers_t);
@@ -187,3 +354,46 @@ class CPU {
         // DAA
         void daa();
 };
+
+inline void CPU::write_register(Registers_t reg, uint16_t data) {
+    // Writing F directly discards any pending flag operation
+    if (reg == REG_F || reg == REG_AF) {
+        m_lazy_flags.operation = FLAGS_MATERIALIZED;
+    }
+
+    m_registers.write_register(reg, data);
+}
+
+inline uint16_t CPU::read_register(Registers_t reg) {
+    if (reg == REG_F || reg == REG_AF) {
+        this->materialize_flags();
+    }
+
+    return m_registers.read_register(reg);
+}
+
+inline void CPU::set_lazy_flags(FlagOperation_t operation, uint8_t operand_1, uint8_t operand_2, uint8_t carry, uint8_t result) {
+    m_lazy_flags.operation = operation;
+    m_lazy_flags.operand_1 = operand_1;
+    m_lazy_flags.operand_2 = operand_2;
+    m_lazy_flags.carry = carry;
+    m_lazy_flags.result = result;
+}
+
+// Carry flag only, without materializing the rest of F
+inline bool CPU::carry_flag() const {
+    const LazyFlags_t &lazy = m_lazy_flags;
+
+    switch (lazy.operation) {
+        case FLAGS_ADD:
+            return (lazy.operand_1 + lazy.operand_2 + lazy.carry) > 0xFF;
+        case FLAGS_SUB:
+            return lazy.operand_1 < (lazy.operand_2 + lazy.carry);
+        case FLAGS_INC:
+        case FLAGS_DEC:
+        case FLAGS_ZERO:
+            return (lazy.carry & CARRY_FLAG) != 0;
+        default:
+            return (m_registers.read_F() & CARRY_FLAG) != 0;
+    }
+}
@@ -3,7 +3,7 @@
 // ADD A, n
 // ADC A, n
 void CPU::alu_add(Registers_t reg, bool carry) {
-    uint8_t A = this->read_register(REG_A);
+    uint8_t A = m_registers.read_A();
     uint16_t n;
 
     if (reg == REG_HL) {
@@ -17,58 +17,34 @@ void CPU::alu_add(Registers_t reg, bool carry) {
     uint8_t carry_bit = 0;
 
     if (carry) {
-        carry_bit = (this->read_flag_register(CARRY_FLAG)) ? 1 : 0;
+        carry_bit = this->carry_flag();
         result_full += carry_bit;
     }
 
     uint8_t result = static_cast<uint8_t>(result_full);
 
-    this->reset_flag_register();
-
-    if (result == 0) {
-        this->set_flag_register(ZERO_FLAG, true);
-    }
-
-    if (result_full > 0xFF) {
-        this->set_flag_register(CARRY_FLAG, true);
-    }
-
-    if (((A & 0xF) + (n & 0xF) + carry_bit) > 0x0F) {
-        this->set_flag_register(HALF_CARRY_FLAG, true);
-    }
+    this->set_lazy_flags(FLAGS_ADD, A, n, carry_bit, result);
 
     
-    if (carry) { log_cpu("ADC A, %s", reg); }
+    if (carry) { log_cpu("ADC A, %s", CPURegisters::to_string(reg)); }
     else { log_cpu("ADD A, %s", CPURegisters::to_string(reg)); }
     
 
-    this->write_register(REG_A, result);
+    m_registers.write_A(result);
 }
 
 void CPU::alu_add(uint8_t n, bool carry) {
-    uint8_t A = this->read_register(REG_A);
+    uint8_t A = m_registers.read_A();
     uint16_t result_full = A + n;
     uint8_t carry_bit = 0;
 
     if (carry) {
-        carry_bit = (this->read_flag_register(CARRY_FLAG)) ? 1 : 0;
+        carry_bit = this->carry_flag();
         result_full += carry_bit;
     }
     uint8_t result = static_cast<uint8_t>(result_full);
 
-    this->reset_flag_register();
-
-    if (result == 0) {
-        this->set_flag_register(ZERO_FLAG, true);
-    }
-
-    if (result_full > 0xFF) {
-        this->set_flag_register(CARRY_FLAG, true);
-    }
-
-    if (((A & 0xF) + (n & 0xF) + carry_bit) > 0x0F) {
-        this->set_flag_register(HALF_CARRY_FLAG, true);
-    }
+    this->set_lazy_flags(FLAGS_ADD, A, n, carry_bit, result);
 
     
     if (carry) { log_cpu("ADC A, %X", n); }
@@ -76,13 +52,13 @@ void CPU::alu_add(uint8_t n, bool carry) {
     
 
 
-    this->write_register(REG_A, result);
+    m_registers.write_A(result);
 }
 
 // SUB n
 // SBC n
 void CPU::alu_sub(Registers_t reg, bool carry) {
-    uint8_t A = this->read_register(REG_A);
+    uint8_t A = m_registers.read_A();
     uint8_t n;
     uint8_t carry_bit = 0;
 
@@ -94,7 +70,7 @@ void CPU::alu_sub(Registers_t reg, bool carry) {
     }
 
     if (carry) {
-        carry_bit = (this->read_flag_register(CARRY_FLAG)) ? 1 : 0;
+        carry_bit = this->carry_flag();
     }
 
     int result_full = A - n - carry_bit;
@@ -103,25 +79,17 @@ void CPU::alu_sub(Registers_t reg, bool carry) {
     if (carry) { log_cpu("SBC A, %s", CPURegisters::to_string(reg)); }
     else { log_cpu("SUB A(%X), %s", A, CPURegisters::to_string(reg)); }
 
-    this->write_register(REG_A, result);
-    
-    bool borrow = result_full < 0;
-    bool half_borrow = ((A & 0xF) - (n & 0xF) - carry_bit) < 0;
-
-    this->reset_flag_register();
+    m_registers.write_A(result);
 
-    this->set_flag_register(SUBTRACT_FLAG, true);
-    this->set_flag_register(ZERO_FLAG, (result == 0));
-    this->set_flag_register(HALF_CARRY_FLAG, half_borrow);
-    this->set_flag_register(CARRY_FLAG, borrow);
+    this->set_lazy_flags(FLAGS_SUB, A, n, carry_bit, result);
 }
 
 void CPU::alu_sub(uint8_t n, bool carry) {
-    uint8_t A = this->read_register(REG_A);
+    uint8_t A = m_registers.read_A();
     uint8_t carry_bit = 0;
 
     if (carry) {
-        carry_bit = (this->read_flag_register(CARRY_FLAG)) ? 1 : 0;
+        carry_bit = this->carry_flag();
     }
 
     int result_full = A - n - carry_bit;
@@ -130,25 +98,14 @@ void CPU::alu_sub(uint8_t n, bool carry) {
     if (carry) { log_cpu("SBC A, %X", n ); }
     else { log_cpu("SUB A(%X), %X", A, n); }
 
-    this->write_register(REG_A, result);
-    
-    bool borrow = result_full < 0;
-    bool half_borrow = ((A & 0xF) - (n & 0xF) - carry_bit) < 0;
+    m_registers.write_A(result);
 
-    this->reset_flag_register();
-
-    this->set_flag_register(SUBTRACT_FLAG, true);
-    this->set_flag_register(ZERO_FLAG, (result == 0));
-    this->set_flag_register(HALF_CARRY_FLAG, half_borrow);
-    this->set_flag_register(CARRY_FLAG, borrow);
+    this->set_lazy_flags(FLAGS_SUB, A, n, carry_bit, result);
 }
 
 // AND n
 void CPU::alu_and(Registers_t reg) {
-    this->reset_flag_register();
-    this->set_flag_register(HALF_CARRY_FLAG, true);
-
-    uint8_t A = this->read_register(REG_A);
+    uint8_t A = m_registers.read_A();
     uint16_t n = this->read_register(reg);
     
     if (reg == REG_HL) {
@@ -157,38 +114,29 @@ void CPU::alu_and(Registers_t reg) {
 
     uint8_t result = A & n;
 
-    if (result == 0) {
-        this->set_flag_register(ZERO_FLAG, true);
-    }
+    this->set_lazy_flags(FLAGS_ZERO, A, n, HALF_CARRY_FLAG, result);
 
     log_cpu("AND A, %s", CPURegisters::to_string(reg));
 
-    this->write_register(REG_A, result);
+    m_registers.write_A(result);
 }
 
 void CPU::alu_and(uint8_t n) {
-    this->reset_flag_register();
-    this->set_flag_register(HALF_CARRY_FLAG, true);
-
-    uint8_t A = this->read_register(REG_A);
+    uint8_t A = m_registers.read_A();
     uint8_t result = A & n;
 
-    if (result == 0) {
-        this->set_flag_register(ZERO_FLAG, true);
-    }
+    this->set_lazy_flags(FLAGS_ZERO, A, n, HALF_CARRY_FLAG, result);
 
     
     log_cpu("AND A, %X", n );
     
 
-    this->write_register(REG_A, result);
+    m_registers.write_A(result);
 }
 
 // OR n
 void CPU::alu_or(Registers_t reg) {
-    this->reset_flag_register();
-
-    uint8_t A = this->read_register(REG_A);
+    uint8_t A = m_registers.read_A();
     uint16_t n = this->read_register(reg);
     
     if (reg == REG_HL) {
@@ -197,37 +145,29 @@ void CPU::alu_or(Registers_t reg) {
     
     uint8_t result = A | n;
 
-    if (result == 0) {
-        this->set_flag_register(ZERO_FLAG, true);
-    }
+    this->set_lazy_flags(FLAGS_ZERO, A, n, 0, result);
 
     log_cpu("OR A(%X), %s(%X)", A, CPURegisters::to_string(reg), n);
 
-    this->write_register(REG_A, result);
+    m_registers.write_A(result);
 }
 
 void CPU::alu_or(uint8_t n) {
-    this->reset_flag_register();
-
-    uint8_t A = this->read_register(REG_A);
+    uint8_t A = m_registers.read_A();
     uint8_t result = A | n;
 
-    if (result == 0) {
-        this->set_flag_register(ZERO_FLAG, true);
-    }
+    this->set_lazy_flags(FLAGS_ZERO, A, n, 0, result);
 
     
     log_cpu("OR A, %X", n );
     
 
-    this->write_register(REG_A, result);
+    m_registers.write_A(result);
 }
 
 // XOR n
 void CPU::alu_xor(Registers_t reg) {
-    this->reset_flag_register();
-
-    uint8_t A = this->read_register(REG_A);
+    uint8_t A = m_registers.read_A();
     uint16_t n = this->read_register(reg);
     
     if (reg == REG_HL) {
@@ -236,35 +176,29 @@ void CPU::alu_xor(Registers_t reg) {
     
     uint8_t result = A ^ n;
 
-    if (result == 0) {
-        this->set_flag_register(ZERO_FLAG, true);
-    }
+    this->set_lazy_flags(FLAGS_ZERO, A, n, 0, result);
 
     log_cpu("XOR A, %s", CPURegisters::to_string(reg));
 
-    this->write_register(REG_A, result);
+    m_registers.write_A(result);
 }
 
 void CPU::alu_xor(uint8_t n) {
-    this->reset_flag_register();
-
-    uint8_t A = this->read_register(REG_A);
+    uint8_t A = m_registers.read_A();
     uint8_t result = A ^ n;
 
-    if (result == 0) {
-        this->set_flag_register(ZERO_FLAG, true);
-    }
+    this->set_lazy_flags(FLAGS_ZERO, A, n, 0, result);
     
     
     log_cpu("XOR A, %X", n);
     
 
-    this->write_register(REG_A, result);
+    m_registers.write_A(result);
 }
 
 // CP n
 void CPU::alu_cp(Registers_t reg) {
-    uint8_t A = this->read_register(REG_A);
+    uint8_t A = m_registers.read_A();
     uint16_t n = this->read_register(reg);
     
     if (reg == REG_HL) {
@@ -273,32 +207,16 @@ void CPU::alu_cp(Registers_t reg) {
 
     uint8_t result = static_cast<uint8_t>(A - n);
 
-    bool borrow = A < n;
-    bool half_borrow = ((A & 0xF) - (n & 0xF)) < 0;
-
-    this->reset_flag_register();
-
-    this->set_flag_register(SUBTRACT_FLAG, true);
-    this->set_flag_register(ZERO_FLAG, (result == 0));
-    this->set_flag_register(HALF_CARRY_FLAG, half_borrow);
-    this->set_flag_register(CARRY_FLAG, borrow);
+    this->set_lazy_flags(FLAGS_SUB, A, n, 0, result);
 
     log_cpu("CP A(%X), %s(%X)", A, CPURegisters::to_string(reg), n);
 }
 
 void CPU::alu_cp(uint8_t n) {
-    uint8_t A = this->read_register(REG_A);
+    uint8_t A = m_registers.read_A();
     uint8_t result = static_cast<uint8_t>(A - n);
 
-    bool borrow = A < n;
-    bool half_borrow = ((A & 0xF) - (n & 0xF)) < 0;
-
-    this->reset_flag_register();
-
-    this->set_flag_register(SUBTRACT_FLAG, true);
-    this->set_flag_register(ZERO_FLAG, (result == 0));
-    this->set_flag_register(HALF_CARRY_FLAG, half_borrow);
-    this->set_flag_register(CARRY_FLAG, borrow);
+    this->set_lazy_flags(FLAGS_SUB, A, n, 0, result);
 
     log_cpu("CP A(%X), %X", A, n);
 }
@@ -315,9 +233,8 @@ void CPU::alu_inc(Registers_t reg) {
 
     uint8_t result = static_cast<uint8_t>(N + 1);
 
-    this->set_flag_register(SUBTRACT_FLAG, false);
-    this->set_flag_register(ZERO_FLAG, (result == 0));
-    this->set_flag_register(HALF_CARRY_FLAG, ((N & 0xF) + 1 > 0x0F));
+    // INC preserves the carry flag
+    this->set_lazy_flags(FLAGS_INC, N, 1, (this->carry_flag()) ? CARRY_FLAG : 0, result);
 
     log_cpu("INC %s", CPURegisters::to_string(reg));
 
@@ -342,9 +259,8 @@ void CPU::alu_dec(Registers_t reg) {
 
     log_cpu("DEC %s", CPURegisters::to_string(reg));
 
-    this->set_flag_register(SUBTRACT_FLAG, true);
-    this->set_flag_register(ZERO_FLAG, (result == 0));
-    this->set_flag_register(HALF_CARRY_FLAG, (result & 0x0F) == 0x0F);
+    // DEC preserves the carry flag
+    this->set_lazy_flags(FLAGS_DEC, N, 1, (this->carry_flag()) ? CARRY_FLAG : 0, result);
 
     if (reg == REG_HL) {
         this->write_memory(result);
@@ -357,7 +273,7 @@ void CPU::alu_dec(Registers_t reg) {
 /****    16-Bit ALU    ****/
 // ADD HL, nn
 void CPU::alu_add_HL(Registers_t reg) {
-    uint16_t HL = this->read_register(REG_HL);
+    uint16_t HL = m_registers.read_HL();
     uint16_t nn = this->read_register(reg);
     uint32_t result_full = HL + nn;
 
@@ -368,12 +284,12 @@ void CPU::alu_add_HL(Registers_t reg) {
     log_cpu("ADD HL, %s", CPURegisters::to_string(reg));
 
     uint16_t result = static_cast<uint16_t>(result_full);
-    this->write_register(REG_HL, result);
+    m_registers.write_HL(result);
 }
 
 // ADD SP, e
 void CPU::alu_add_SP(int8_t n) {
-    uint16_t SP = this->read_register(REG_SP);
+    uint16_t SP = m_registers.read_SP();
     int result_full = static_cast<int>(SP + n);
     uint16_t result = static_cast<uint16_t>(result_full);
 
@@ -383,7 +299,7 @@ void CPU::alu_add_SP(int8_t n) {
 
     log_cpu("ADD SP, %X", n);
 
-    this->write_register(REG_SP, result);
+    m_registers.write_SP(result);
 }
 
 // INC nn
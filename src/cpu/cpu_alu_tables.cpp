@@ -0,0 +1,79 @@
+#include "cpu_alu_tables.h"
+#include "cpu.h"
+
+
+// Built once at startup, C++11 constexpr functions cannot contain the loops needed to generate these
+const ALUTables alu_tables;
+
+
+ALUTables::ALUTables() {
+    for (int carry = 0; carry < 2; carry++) {
+        for (int A = 0; A < 256; A++) {
+            for (int n = 0; n < 256; n++) {
+                int index = (carry << 16) | (A << 8) | n;
+
+                int sum = A + n + carry;
+                bool half_carry = ((A & 0xF) + (n & 0xF) + carry) > 0x0F;
+
+                m_add_flags[index] = (((sum & 0xFF) == 0) ? ZERO_FLAG : 0)
+                    | ((half_carry) ? HALF_CARRY_FLAG : 0)
+                    | ((sum > 0xFF) ? CARRY_FLAG : 0);
+
+                int difference = A - n - carry;
+                bool half_borrow = ((A & 0xF) - (n & 0xF) - carry) < 0;
+
+                m_sub_flags[index] = SUBTRACT_FLAG
+                    | (((difference & 0xFF) == 0) ? ZERO_FLAG : 0)
+                    | ((half_borrow) ? HALF_CARRY_FLAG : 0)
+                    | ((difference < 0) ? CARRY_FLAG : 0);
+            }
+        }
+    }
+
+    for (int n = 0; n < 256; n++) {
+        uint8_t inc = static_cast<uint8_t>(n + 1);
+        m_inc_flags[n] = ((inc == 0) ? ZERO_FLAG : 0)
+            | (((n & 0xF) == 0x0F) ? HALF_CARRY_FLAG : 0);
+
+        uint8_t dec = static_cast<uint8_t>(n - 1);
+        m_dec_flags[n] = SUBTRACT_FLAG
+            | ((dec == 0) ? ZERO_FLAG : 0)
+            | (((dec & 0xF) == 0x0F) ? HALF_CARRY_FLAG : 0);
+    }
+
+    // Index bits 8-10 are the N, H and C flags, matching bits 4-6 of F
+    for (int flag_bits = 0; flag_bits < 8; flag_bits++) {
+        bool subtract = (flag_bits & 0x4) != 0;
+        bool half_carry = (flag_bits & 0x2) != 0;
+
+        for (int A = 0; A < 256; A++) {
+            bool carry = (flag_bits & 0x1) != 0;
+            uint8_t result = A;
+
+            if (subtract) {
+                if (carry) {
+                    result -= 0x60;
+                }
+                if (half_carry) {
+                    result -= 0x06;
+                }
+            }
+            else {
+                if (carry || result > 0x99) {
+                    carry = true;
+                    result += 0x60;
+                }
+                if (half_carry || (result & 0x0F) > 0x09) {
+                    result += 0x06;
+                }
+            }
+
+            // H is always reset and N is unchanged
+            uint8_t flags = ((subtract) ? SUBTRACT_FLAG : 0)
+                | ((result == 0) ? ZERO_FLAG : 0)
+                | ((carry) ? CARRY_FLAG : 0);
+
+            m_daa[(flag_bits << 8) | A] = (result << 8) | flags;
+        }
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <iostream>
+
+
+// Precomputed results and flags for the 8-bit ALU
+// ADD and SUB tables are indexed by carry in, A and the operand, INC and DEC by the operand
+// and DAA by the N, H and C flags and A.
+// ADD and SUB only store F. Each op computes its result when it runs, and with lazy flags
+// the table is read later from the saved operands, where the result is not needed.
+class ALUTables {
+    public:
+        ALUTables();
+
+        // F after ADD/ADC A, n
+        uint8_t add_flags(uint8_t A, uint8_t n, uint8_t carry) const { return m_add_flags[(carry << 16) | (A << 8) | n]; }
+        // F after SUB/SBC/CP A, n
+        uint8_t sub_flags(uint8_t A, uint8_t n, uint8_t carry) const { return m_sub_flags[(carry << 16) | (A << 8) | n]; }
+        // Z, N and H after INC/DEC n, the carry flag is not affected
+        uint8_t inc_flags(uint8_t n) const { return m_inc_flags[n]; }
+        uint8_t dec_flags(uint8_t n) const { return m_dec_flags[n]; }
+        // Adjusted A in the high byte and F in the low byte after DAA
+        uint16_t daa(uint8_t A, uint8_t F) const { return m_daa[((F & 0x70) << 4) | A]; }
+
+    private:
+        uint8_t m_add_flags[2 * 256 * 256];
+        uint8_t m_sub_flags[2 * 256 * 256];
+        uint8_t m_inc_flags[256];
+        uint8_t m_dec_flags[256];
+        uint16_t m_daa[8 * 256];
+};
+
+
+extern const ALUTables alu_tables;
@@ -0,0 +1,1049 @@
+#include "cpu.h"
+
+// Register operands encoded in bits 0-2 or 3-5 of an opcode, 6 is (HL)
+static const Registers_t s_register_operands[8] = {
+    REG_B, REG_C, REG_D, REG_E, REG_H, REG_L, REG_HL, REG_A
+};
+
+// 16-bit register operands encoded in bits 4-5 of an opcode
+static const Registers_t s_register_pair_operands[4] = {
+    REG_BC, REG_DE, REG_HL, REG_SP
+};
+
+// PUSH and POP use AF in place of SP
+static const Registers_t s_stack_register_operands[4] = {
+    REG_BC, REG_DE, REG_HL, REG_AF
+};
+
+// Conditions encoded in bits 3-4 of an opcode: NZ, Z, NC, C
+static const CPUFlag_t s_condition_flags[4] = {
+    ZERO_FLAG, ZERO_FLAG, CARRY_FLAG, CARRY_FLAG
+};
+
+static const bool s_condition_set[4] = {
+    false, true, false, true
+};
+
+static const char *s_condition_names[4] = {
+    "NZ", "Z", "NC", "C"
+};
+
+static inline Registers_t source_register(uint8_t opcode) {
+    return s_register_operands[opcode & 0x07];
+}
+
+static inline Registers_t destination_register(uint8_t opcode) {
+    return s_register_operands[(opcode >> 3) & 0x07];
+}
+
+static inline Registers_t register_pair(uint8_t opcode) {
+    return s_register_pair_operands[(opcode >> 4) & 0x03];
+}
+
+static inline int condition(uint8_t opcode) {
+    return (opcode >> 3) & 0x03;
+}
+
+const Instruction_t CPU::s_instruction_table[256] = {
+    {&CPU::op_nop, 4, 4},         // 0x00 NOP
+    {&CPU::op_ld_rr_nn, 12, 12},  // 0x01 LD BC, nn
+    {&CPU::op_ld_rr_a, 8, 8},     // 0x02 LD (BC), A
+    {&CPU::op_inc_rr, 8, 8},      // 0x03 INC BC
+    {&CPU::op_inc_r, 4, 4},       // 0x04 INC B
+    {&CPU::op_dec_r, 4, 4},       // 0x05 DEC B
+    {&CPU::op_ld_r_n, 8, 8},      // 0x06 LD B, n
+    {&CPU::op_rlca, 4, 4},        // 0x07 RLCA
+    {&CPU::op_ld_nn_sp, 20, 20},  // 0x08 LD (nn), SP
+    {&CPU::op_add_hl_rr, 8, 8},   // 0x09 ADD HL, BC
+    {&CPU::op_ld_a_rr, 8, 8},     // 0x0A LD A, (BC)
+    {&CPU::op_dec_rr, 8, 8},      // 0x0B DEC BC
+    {&CPU::op_inc_r, 4, 4},       // 0x0C INC C
+    {&CPU::op_dec_r, 4, 4},       // 0x0D DEC C
+    {&CPU::op_ld_r_n, 8, 8},      // 0x0E LD C, n
+    {&CPU::op_rrca, 4, 4},        // 0x0F RRCA
+    {&CPU::op_stop, 4, 4},        // 0x10 STOP
+    {&CPU::op_ld_rr_nn, 12, 12},  // 0x11 LD DE, nn
+    {&CPU::op_ld_rr_a, 8, 8},     // 0x12 LD (DE), A
+    {&CPU::op_inc_rr, 8, 8},      // 0x13 INC DE
+    {&CPU::op_inc_r, 4, 4},       // 0x14 INC D
+    {&CPU::op_dec_r, 4, 4},       // 0x15 DEC D
+    {&CPU::op_ld_r_n, 8, 8},      // 0x16 LD D, n
+    {&CPU::op_rla, 4, 4},         // 0x17 RLA
+    {&CPU::op_jr, 12, 12},        // 0x18 JR e
+    {&CPU::op_add_hl_rr, 8, 8},   // 0x19 ADD HL, DE
+    {&CPU::op_ld_a_rr, 8, 8},     // 0x1A LD A, (DE)
+    {&CPU::op_dec_rr, 8, 8},      // 0x1B DEC DE
+    {&CPU::op_inc_r, 4, 4},       // 0x1C INC E
+    {&CPU::op_dec_r, 4, 4},       // 0x1D DEC E
+    {&CPU::op_ld_r_n, 8, 8},      // 0x1E LD E, n
+    {&CPU::op_rra, 4, 4},         // 0x1F RRA
+    {&CPU::op_jr_cc, 8, 12},      // 0x20 JR NZ, e
+    {&CPU::op_ld_rr_nn, 12, 12},  // 0x21 LD HL, nn
+    {&CPU::op_ldi_hl_a, 8, 8},    // 0x22 LDI (HL), A
+    {&CPU::op_inc_rr, 8, 8},      // 0x23 INC HL
+    {&CPU::op_inc_r, 4, 4},       // 0x24 INC H
+    {&CPU::op_dec_r, 4, 4},       // 0x25 DEC H
+    {&CPU::op_ld_r_n, 8, 8},      // 0x26 LD H, n
+    {&CPU::op_daa, 4, 4},         // 0x27 DAA
+    {&CPU::op_jr_cc, 8, 12},      // 0x28 JR Z, e
+    {&CPU::op_add_hl_rr, 8, 8},   // 0x29 ADD HL, HL
+    {&CPU::op_ldi_a_hl, 8, 8},    // 0x2A LDI A, (HL)
+    {&CPU::op_dec_rr, 8, 8},      // 0x2B DEC HL
+    {&CPU::op_inc_r, 4, 4},       // 0x2C INC L
+    {&CPU::op_dec_r, 4, 4},       // 0x2D DEC L
+    {&CPU::op_ld_r_n, 8, 8},      // 0x2E LD L, n
+    {&CPU::op_cpl, 4, 4},         // 0x2F CPL
+    {&CPU::op_jr_cc, 8, 12},      // 0x30 JR NC, e
+    {&CPU::op_ld_rr_nn, 12, 12},  // 0x31 LD SP, nn
+    {&CPU::op_ldd_hl_a, 8, 8},    // 0x32 LDD (HL), A
+    {&CPU::op_inc_rr, 8, 8},      // 0x33 INC SP
+    {&CPU::op_inc_r, 12, 12},     // 0x34 INC (HL)
+    {&CPU::op_dec_r, 12, 12},     // 0x35 DEC (HL)
+    {&CPU::op_ld_hl_n, 12, 12},   // 0x36 LD (HL), n
+    {&CPU::op_scf, 4, 4},         // 0x37 SCF
+    {&CPU::op_jr_cc, 8, 12},      // 0x38 JR C, e
+    {&CPU::op_add_hl_rr, 8, 8},   // 0x39 ADD HL, SP
+    {&CPU::op_ldd_a_hl, 8, 8},    // 0x3A LDD A, (HL)
+    {&CPU::op_dec_rr, 8, 8},      // 0x3B DEC SP
+    {&CPU::op_inc_r, 4, 4},       // 0x3C INC A
+    {&CPU::op_dec_r, 4, 4},       // 0x3D DEC A
+    {&CPU::op_ld_r_n, 8, 8},      // 0x3E LD A, n
+    {&CPU::op_ccf, 4, 4},         // 0x3F CCF
+    {&CPU::op_ld_r_r, 4, 4},      // 0x40 LD B, B
+    {&CPU::op_ld_r_r, 4, 4},      // 0x41 LD B, C
+    {&CPU::op_ld_r_r, 4, 4},      // 0x42 LD B, D
+    {&CPU::op_ld_r_r, 4, 4},      // 0x43 LD B, E
+    {&CPU::op_ld_r_r, 4, 4},      // 0x44 LD B, H
+    {&CPU::op_ld_r_r, 4, 4},      // 0x45 LD B, L
+    {&CPU::op_ld_r_hl, 8, 8},     // 0x46 LD B, (HL)
+    {&CPU::op_ld_r_r, 4, 4},      // 0x47 LD B, A
+    {&CPU::op_ld_r_r, 4, 4},      // 0x48 LD C, B
+    {&CPU::op_ld_r_r, 4, 4},      // 0x49 LD C, C
+    {&CPU::op_ld_r_r, 4, 4},      // 0x4A LD C, D
+    {&CPU::op_ld_r_r, 4, 4},      // 0x4B LD C, E
+    {&CPU::op_ld_r_r, 4, 4},      // 0x4C LD C, H
+    {&CPU::op_ld_r_r, 4, 4},      // 0x4D LD C, L
+    {&CPU::op_ld_r_hl, 8, 8},     // 0x4E LD C, (HL)
+    {&CPU::op_ld_r_r, 4, 4},      // 0x4F LD C, A
+    {&CPU::op_ld_r_r, 4, 4},      // 0x50 LD D, B
+    {&CPU::op_ld_r_r, 4, 4},      // 0x51 LD D, C
+    {&CPU::op_ld_r_r, 4, 4},      // 0x52 LD D, D
+    {&CPU::op_ld_r_r, 4, 4},      // 0x53 LD D, E
+    {&CPU::op_ld_r_r, 4, 4},      // 0x54 LD D, H
+    {&CPU::op_ld_r_r, 4, 4},      // 0x55 LD D, L
+    {&CPU::op_ld_r_hl, 8, 8},     // 0x56 LD D, (HL)
+    {&CPU::op_ld_r_r, 4, 4},      // 0x57 LD D, A
+    {&CPU::op_ld_r_r, 4, 4},      // 0x58 LD E, B
+    {&CPU::op_ld_r_r, 4, 4},      // 0x59 LD E, C
+    {&CPU::op_ld_r_r, 4, 4},      // 0x5A LD E, D
+    {&CPU::op_ld_r_r, 4, 4},      // 0x5B LD E, E
+    {&CPU::op_ld_r_r, 4, 4},      // 0x5C LD E, H
+    {&CPU::op_ld_r_r, 4, 4},      // 0x5D LD E, L
+    {&CPU::op_ld_r_hl, 8, 8},     // 0x5E LD E, (HL)
+    {&CPU::op_ld_r_r, 4, 4},      // 0x5F LD E, A
+    {&CPU::op_ld_r_r, 4, 4},      // 0x60 LD H, B
+    {&CPU::op_ld_r_r, 4, 4},      // 0x61 LD H, C
+    {&CPU::op_ld_r_r, 4, 4},      // 0x62 LD H, D
+    {&CPU::op_ld_r_r, 4, 4},      // 0x63 LD H, E
+    {&CPU::op_ld_r_r, 4, 4},      // 0x64 LD H, H
+    {&CPU::op_ld_r_r, 4, 4},      // 0x65 LD H, L
+    {&CPU::op_ld_r_hl, 8, 8},     // 0x66 LD H, (HL)
+    {&CPU::op_ld_r_r, 4, 4},      // 0x67 LD H, A
+    {&CPU::op_ld_r_r, 4, 4},      // 0x68 LD L, B
+    {&CPU::op_ld_r_r, 4, 4},      // 0x69 LD L, C
+    {&CPU::op_ld_r_r, 4, 4},      // 0x6A LD L, D
+    {&CPU::op_ld_r_r, 4, 4},      // 0x6B LD L, E
+    {&CPU::op_ld_r_r, 4, 4},      // 0x6C LD L, H
+    {&CPU::op_ld_r_r, 4, 4},      // 0x6D LD L, L
+    {&CPU::op_ld_r_hl, 8, 8},     // 0x6E LD L, (HL)
+    {&CPU::op_ld_r_r, 4, 4},      // 0x6F LD L, A
+    {&CPU::op_ld_hl_r, 8, 8},     // 0x70 LD (HL), B
+    {&CPU::op_ld_hl_r, 8, 8},     // 0x71 LD (HL), C
+    {&CPU::op_ld_hl_r, 8, 8},     // 0x72 LD (HL), D
+    {&CPU::op_ld_hl_r, 8, 8},     // 0x73 LD (HL), E
+    {&CPU::op_ld_hl_r, 8, 8},     // 0x74 LD (HL), H
+    {&CPU::op_ld_hl_r, 8, 8},     // 0x75 LD (HL), L
+    {&CPU::op_halt, 4, 4},        // 0x76 HALT
+    {&CPU::op_ld_hl_r, 8, 8},     // 0x77 LD (HL), A
+    {&CPU::op_ld_r_r, 4, 4},      // 0x78 LD A, B
+    {&CPU::op_ld_r_r, 4, 4},      // 0x79 LD A, C
+    {&CPU::op_ld_r_r, 4, 4},      // 0x7A LD A, D
+    {&CPU::op_ld_r_r, 4, 4},      // 0x7B LD A, E
+    {&CPU::op_ld_r_r, 4, 4},      // 0x7C LD A, H
+    {&CPU::op_ld_r_r, 4, 4},      // 0x7D LD A, L
+    {&CPU::op_ld_r_hl, 8, 8},     // 0x7E LD A, (HL)
+    {&CPU::op_ld_r_r, 4, 4},      // 0x7F LD A, A
+    {&CPU::op_add_r, 4, 4},       // 0x80 ADD A, B
+    {&CPU::op_add_r, 4, 4},       // 0x81 ADD A, C
+    {&CPU::op_add_r, 4, 4},       // 0x82 ADD A, D
+    {&CPU::op_add_r, 4, 4},       // 0x83 ADD A, E
+    {&CPU::op_add_r, 4, 4},       // 0x84 ADD A, H
+    {&CPU::op_add_r, 4, 4},       // 0x85 ADD A, L
+    {&CPU::op_add_r, 8, 8},       // 0x86 ADD A, (HL)
+    {&CPU::op_add_r, 4, 4},       // 0x87 ADD A, A
+    {&CPU::op_adc_r, 4, 4},       // 0x88 ADC A, B
+    {&CPU::op_adc_r, 4, 4},       // 0x89 ADC A, C
+    {&CPU::op_adc_r, 4, 4},       // 0x8A ADC A, D
+    {&CPU::op_adc_r, 4, 4},       // 0x8B ADC A, E
+    {&CPU::op_adc_r, 4, 4},       // 0x8C ADC A, H
+    {&CPU::op_adc_r, 4, 4},       // 0x8D ADC A, L
+    {&CPU::op_adc_r, 8, 8},       // 0x8E ADC A, (HL)
+    {&CPU::op_adc_r, 4, 4},       // 0x8F ADC A, A
+    {&CPU::op_sub_r, 4, 4},       // 0x90 SUB B
+    {&CPU::op_sub_r, 4, 4},       // 0x91 SUB C
+    {&CPU::op_sub_r, 4, 4},       // 0x92 SUB D
+    {&CPU::op_sub_r, 4, 4},       // 0x93 SUB E
+    {&CPU::op_sub_r, 4, 4},       // 0x94 SUB H
+    {&CPU::op_sub_r, 4, 4},       // 0x95 SUB L
+    {&CPU::op_sub_r, 8, 8},       // 0x96 SUB (HL)
+    {&CPU::op_sub_r, 4, 4},       // 0x97 SUB A
+    {&CPU::op_sbc_r, 4, 4},       // 0x98 SBC A, B
+    {&CPU::op_sbc_r, 4, 4},       // 0x99 SBC A, C
+    {&CPU::op_sbc_r, 4, 4},       // 0x9A SBC A, D
+    {&CPU::op_sbc_r, 4, 4},       // 0x9B SBC A, E
+    {&CPU::op_sbc_r, 4, 4},       // 0x9C SBC A, H
+    {&CPU::op_sbc_r, 4, 4},       // 0x9D SBC A, L
+    {&CPU::op_sbc_r, 8, 8},       // 0x9E SBC A, (HL)
+    {&CPU::op_sbc_r, 4, 4},       // 0x9F SBC A, A
+    {&CPU::op_and_r, 4, 4},       // 0xA0 AND B
+    {&CPU::op_and_r, 4, 4},       // 0xA1 AND C
+    {&CPU::op_and_r, 4, 4},       // 0xA2 AND D
+    {&CPU::op_and_r, 4, 4},       // 0xA3 AND E
+    {&CPU::op_and_r, 4, 4},       // 0xA4 AND H
+    {&CPU::op_and_r, 4, 4},       // 0xA5 AND L
+    {&CPU::op_and_r, 8, 8},       // 0xA6 AND (HL)
+    {&CPU::op_and_r, 4, 4},       // 0xA7 AND A
+    {&CPU::op_xor_r, 4, 4},       // 0xA8 XOR B
+    {&CPU::op_xor_r, 4, 4},       // 0xA9 XOR C
+    {&CPU::op_xor_r, 4, 4},       // 0xAA XOR D
+    {&CPU::op_xor_r, 4, 4},       // 0xAB XOR E
+    {&CPU::op_xor_r, 4, 4},       // 0xAC XOR H
+    {&CPU::op_xor_r, 4, 4},       // 0xAD XOR L
+    {&CPU::op_xor_r, 8, 8},       // 0xAE XOR (HL)
+    {&CPU::op_xor_r, 4, 4},       // 0xAF XOR A
+    {&CPU::op_or_r, 4, 4},        // 0xB0 OR B
+    {&CPU::op_or_r, 4, 4},        // 0xB1 OR C
+    {&CPU::op_or_r, 4, 4},        // 0xB2 OR D
+    {&CPU::op_or_r, 4, 4},        // 0xB3 OR E
+    {&CPU::op_or_r, 4, 4},        // 0xB4 OR H
+    {&CPU::op_or_r, 4, 4},        // 0xB5 OR L
+    {&CPU::op_or_r, 8, 8},        // 0xB6 OR (HL)
+    {&CPU::op_or_r, 4, 4},        // 0xB7 OR A
+    {&CPU::op_cp_r, 4, 4},        // 0xB8 CP B
+    {&CPU::op_cp_r, 4, 4},        // 0xB9 CP C
+    {&CPU::op_cp_r, 4, 4},        // 0xBA CP D
+    {&CPU::op_cp_r, 4, 4},        // 0xBB CP E
+    {&CPU::op_cp_r, 4, 4},        // 0xBC CP H
+    {&CPU::op_cp_r, 4, 4},        // 0xBD CP L
+    {&CPU::op_cp_r, 8, 8},        // 0xBE CP (HL)
+    {&CPU::op_cp_r, 4, 4},        // 0xBF CP A
+    {&CPU::op_ret_cc, 8, 20},     // 0xC0 RET NZ
+    {&CPU::op_pop, 12, 12},       // 0xC1 POP BC
+    {&CPU::op_jp_cc, 12, 16},     // 0xC2 JP NZ, nn
+    {&CPU::op_jp, 16, 16},        // 0xC3 JP nn
+    {&CPU::op_call_cc, 12, 24},   // 0xC4 CALL NZ, nn
+    {&CPU::op_push, 16, 16},      // 0xC5 PUSH BC
+    {&CPU::op_add_n, 8, 8},       // 0xC6 ADD A, n
+    {&CPU::op_rst, 16, 16},       // 0xC7 RST 00H
+    {&CPU::op_ret_cc, 8, 20},     // 0xC8 RET Z
+    {&CPU::op_ret, 16, 16},       // 0xC9 RET
+    {&CPU::op_jp_cc, 12, 16},     // 0xCA JP Z, nn
+    {nullptr, 4, 4},              // 0xCB PREFIX CB
+    {&CPU::op_call_cc, 12, 24},   // 0xCC CALL Z, nn
+    {&CPU::op_call, 24, 24},      // 0xCD CALL nn
+    {&CPU::op_adc_n, 8, 8},       // 0xCE ADC A, n
+    {&CPU::op_rst, 16, 16},       // 0xCF RST 08H
+    {&CPU::op_ret_cc, 8, 20},     // 0xD0 RET NC
+    {&CPU::op_pop, 12, 12},       // 0xD1 POP DE
+    {&CPU::op_jp_cc, 12, 16},     // 0xD2 JP NC, nn
+    {&CPU::op_undefined, 4, 4},   // 0xD3 -
+    {&CPU::op_call_cc, 12, 24},   // 0xD4 CALL NC, nn
+    {&CPU::op_push, 16, 16},      // 0xD5 PUSH DE
+    {&CPU::op_sub_n, 8, 8},       // 0xD6 SUB n
+    {&CPU::op_rst, 16, 16},       // 0xD7 RST 10H
+    {&CPU::op_ret_cc, 8, 20},     // 0xD8 RET C
+    {&CPU::op_reti, 16, 16},      // 0xD9 RETI
+    {&CPU::op_jp_cc, 12, 16},     // 0xDA JP C, nn
+    {&CPU::op_undefined, 4, 4},   // 0xDB -
+    {&CPU::op_call_cc, 12, 24},   // 0xDC CALL C, nn
+    {&CPU::op_undefined, 4, 4},   // 0xDD -
+    {&CPU::op_sbc_n, 8, 8},       // 0xDE SBC A, n
+    {&CPU::op_rst, 16, 16},       // 0xDF RST 18H
+    {&CPU::op_ldh_n_a, 12, 12},   // 0xE0 LDH (n), A
+    {&CPU::op_pop, 12, 12},       // 0xE1 POP HL
+    {&CPU::op_ld_c_a, 8, 8},      // 0xE2 LD (C), A
+    {&CPU::op_undefined, 4, 4},   // 0xE3 -
+    {&CPU::op_undefined, 4, 4},   // 0xE4 -
+    {&CPU::op_push, 16, 16},      // 0xE5 PUSH HL
+    {&CPU::op_and_n, 8, 8},       // 0xE6 AND n
+    {&CPU::op_rst, 16, 16},       // 0xE7 RST 20H
+    {&CPU::op_add_sp_e, 16, 16},  // 0xE8 ADD SP, e
+    {&CPU::op_jp_hl, 4, 4},       // 0xE9 JP (HL)
+    {&CPU::op_ld_nn_a, 16, 16},   // 0xEA LD (nn), A
+    {&CPU::op_undefined, 4, 4},   // 0xEB -
+    {&CPU::op_undefined, 4, 4},   // 0xEC -
+    {&CPU::op_undefined, 4, 4},   // 0xED -
+    {&CPU::op_xor_n, 8, 8},       // 0xEE XOR n
+    {&CPU::op_rst, 16, 16},       // 0xEF RST 28H
+    {&CPU::op_ldh_a_n, 12, 12},   // 0xF0 LDH A, (n)
+    {&CPU::op_pop, 12, 12},       // 0xF1 POP AF
+    {&CPU::op_ld_a_c, 8, 8},      // 0xF2 LD A, (C)
+    {&CPU::op_di, 4, 4},          // 0xF3 DI
+    {&CPU::op_undefined, 4, 4},   // 0xF4 -
+    {&CPU::op_push, 16, 16},      // 0xF5 PUSH AF
+    {&CPU::op_or_n, 8, 8},        // 0xF6 OR n
+    {&CPU::op_rst, 16, 16},       // 0xF7 RST 30H
+    {&CPU::op_ld_hl_sp_e, 12, 12}, // 0xF8 LD HL, SP+e
+    {&CPU::op_ld_sp_hl, 8, 8},    // 0xF9 LD SP, HL
+    {&CPU::op_ld_a_nn, 16, 16},   // 0xFA LD A, (nn)
+    {&CPU::op_ei, 4, 4},          // 0xFB EI
+    {&CPU::op_undefined, 4, 4},   // 0xFC -
+    {&CPU::op_undefined, 4, 4},   // 0xFD -
+    {&CPU::op_cp_n, 8, 8},        // 0xFE CP n
+    {&CPU::op_rst, 16, 16},       // 0xFF RST 38H
+};
+
+const Instruction_t CPU::s_cb_instruction_table[256] = {
+    {&CPU::op_rlc, 8, 8},         // 0x00 RLC B
+    {&CPU::op_rlc, 8, 8},         // 0x01 RLC C
+    {&CPU::op_rlc, 8, 8},         // 0x02 RLC D
+    {&CPU::op_rlc, 8, 8},         // 0x03 RLC E
+    {&CPU::op_rlc, 8, 8},         // 0x04 RLC H
+    {&CPU::op_rlc, 8, 8},         // 0x05 RLC L
+    {&CPU::op_rlc, 16, 16},       // 0x06 RLC (HL)
+    {&CPU::op_rlc, 8, 8},         // 0x07 RLC A
+    {&CPU::op_rrc, 8, 8},         // 0x08 RRC B
+    {&CPU::op_rrc, 8, 8},         // 0x09 RRC C
+    {&CPU::op_rrc, 8, 8},         // 0x0A RRC D
+    {&CPU::op_rrc, 8, 8},         // 0x0B RRC E
+    {&CPU::op_rrc, 8, 8},         // 0x0C RRC H
+    {&CPU::op_rrc, 8, 8},         // 0x0D RRC L
+    {&CPU::op_rrc, 16, 16},       // 0x0E RRC (HL)
+    {&CPU::op_rrc, 8, 8},         // 0x0F RRC A
+    {&CPU::op_rl, 8, 8},          // 0x10 RL B
+    {&CPU::op_rl, 8, 8},          // 0x11 RL C
+    {&CPU::op_rl, 8, 8},          // 0x12 RL D
+    {&CPU::op_rl, 8, 8},          // 0x13 RL E
+    {&CPU::op_rl, 8, 8},          // 0x14 RL H
+    {&CPU::op_rl, 8, 8},          // 0x15 RL L
+    {&CPU::op_rl, 16, 16},        // 0x16 RL (HL)
+    {&CPU::op_rl, 8, 8},          // 0x17 RL A
+    {&CPU::op_rr, 8, 8},          // 0x18 RR B
+    {&CPU::op_rr, 8, 8},          // 0x19 RR C
+    {&CPU::op_rr, 8, 8},          // 0x1A RR D
+    {&CPU::op_rr, 8, 8},          // 0x1B RR E
+    {&CPU::op_rr, 8, 8},          // 0x1C RR H
+    {&CPU::op_rr, 8, 8},          // 0x1D RR L
+    {&CPU::op_rr, 16, 16},        // 0x1E RR (HL)
+    {&CPU::op_rr, 8, 8},          // 0x1F RR A
+    {&CPU::op_sla, 8, 8},         // 0x20 SLA B
+    {&CPU::op_sla, 8, 8},         // 0x21 SLA C
+    {&CPU::op_sla, 8, 8},         // 0x22 SLA D
+    {&CPU::op_sla, 8, 8},         // 0x23 SLA E
+    {&CPU::op_sla, 8, 8},         // 0x24 SLA H
+    {&CPU::op_sla, 8, 8},         // 0x25 SLA L
+    {&CPU::op_sla, 16, 16},       // 0x26 SLA (HL)
+    {&CPU::op_sla, 8, 8},         // 0x27 SLA A
+    {&CPU::op_sra, 8, 8},         // 0x28 SRA B
+    {&CPU::op_sra, 8, 8},         // 0x29 SRA C
+    {&CPU::op_sra, 8, 8},         // 0x2A SRA D
+    {&CPU::op_sra, 8, 8},         // 0x2B SRA E
+    {&CPU::op_sra, 8, 8},         // 0x2C SRA H
+    {&CPU::op_sra, 8, 8},         // 0x2D SRA L
+    {&CPU::op_sra, 16, 16},       // 0x2E SRA (HL)
+    {&CPU::op_sra, 8, 8},         // 0x2F SRA A
+    {&CPU::op_swap, 8, 8},        // 0x30 SWAP B
+    {&CPU::op_swap, 8, 8},        // 0x31 SWAP C
+    {&CPU::op_swap, 8, 8},        // 0x32 SWAP D
+    {&CPU::op_swap, 8, 8},        // 0x33 SWAP E
+    {&CPU::op_swap, 8, 8},        // 0x34 SWAP H
+    {&CPU::op_swap, 8, 8},        // 0x35 SWAP L
+    {&CPU::op_swap, 16, 16},      // 0x36 SWAP (HL)
+    {&CPU::op_swap, 8, 8},        // 0x37 SWAP A
+    {&CPU::op_srl, 8, 8},         // 0x38 SRL B
+    {&CPU::op_srl, 8, 8},         // 0x39 SRL C
+    {&CPU::op_srl, 8, 8},         // 0x3A SRL D
+    {&CPU::op_srl, 8, 8},         // 0x3B SRL E
+    {&CPU::op_srl, 8, 8},         // 0x3C SRL H
+    {&CPU::op_srl, 8, 8},         // 0x3D SRL L
+    {&CPU::op_srl, 16, 16},       // 0x3E SRL (HL)
+    {&CPU::op_srl, 8, 8},         // 0x3F SRL A
+    {&CPU::op_bit, 8, 8},         // 0x40 BIT 0, B
+    {&CPU::op_bit, 8, 8},         // 0x41 BIT 0, C
+    {&CPU::op_bit, 8, 8},         // 0x42 BIT 0, D
+    {&CPU::op_bit, 8, 8},         // 0x43 BIT 0, E
+    {&CPU::op_bit, 8, 8},         // 0x44 BIT 0, H
+    {&CPU::op_bit, 8, 8},         // 0x45 BIT 0, L
+    {&CPU::op_bit, 12, 12},       // 0x46 BIT 0, (HL)
+    {&CPU::op_bit, 8, 8},         // 0x47 BIT 0, A
+    {&CPU::op_bit, 8, 8},         // 0x48 BIT 1, B
+    {&CPU::op_bit, 8, 8},         // 0x49 BIT 1, C
+    {&CPU::op_bit, 8, 8},         // 0x4A BIT 1, D
+    {&CPU::op_bit, 8, 8},         // 0x4B BIT 1, E
+    {&CPU::op_bit, 8, 8},         // 0x4C BIT 1, H
+    {&CPU::op_bit, 8, 8},         // 0x4D BIT 1, L
+    {&CPU::op_bit, 12, 12},       // 0x4E BIT 1, (HL)
+    {&CPU::op_bit, 8, 8},         // 0x4F BIT 1, A
+    {&CPU::op_bit, 8, 8},         // 0x50 BIT 2, B
+    {&CPU::op_bit, 8, 8},         // 0x51 BIT 2, C
+    {&CPU::op_bit, 8, 8},         // 0x52 BIT 2, D
+    {&CPU::op_bit, 8, 8},         // 0x53 BIT 2, E
+    {&CPU::op_bit, 8, 8},         // 0x54 BIT 2, H
+    {&CPU::op_bit, 8, 8},         // 0x55 BIT 2, L
+    {&CPU::op_bit, 12, 12},       // 0x56 BIT 2, (HL)
+    {&CPU::op_bit, 8, 8},         // 0x57 BIT 2, A
+    {&CPU::op_bit, 8, 8},         // 0x58 BIT 3, B
+    {&CPU::op_bit, 8, 8},         // 0x59 BIT 3, C
+    {&CPU::op_bit, 8, 8},         // 0x5A BIT 3, D
+    {&CPU::op_bit, 8, 8},         // 0x5B BIT 3, E
+    {&CPU::op_bit, 8, 8},         // 0x5C BIT 3, H
+    {&CPU::op_bit, 8, 8},         // 0x5D BIT 3, L
+    {&CPU::op_bit, 12, 12},       // 0x5E BIT 3, (HL)
+    {&CPU::op_bit, 8, 8},         // 0x5F BIT 3, A
+    {&CPU::op_bit, 8, 8},         // 0x60 BIT 4, B
+    {&CPU::op_bit, 8, 8},         // 0x61 BIT 4, C
+    {&CPU::op_bit, 8, 8},         // 0x62 BIT 4, D
+    {&CPU::op_bit, 8, 8},         // 0x63 BIT 4, E
+    {&CPU::op_bit, 8, 8},         // 0x64 BIT 4, H
+    {&CPU::op_bit, 8, 8},         // 0x65 BIT 4, L
+    {&CPU::op_bit, 12, 12},       // 0x66 BIT 4, (HL)
+    {&CPU::op_bit, 8, 8},         // 0x67 BIT 4, A
+    {&CPU::op_bit, 8, 8},         // 0x68 BIT 5, B
+    {&CPU::op_bit, 8, 8},         // 0x69 BIT 5, C
+    {&CPU::op_bit, 8, 8},         // 0x6A BIT 5, D
+    {&CPU::op_bit, 8, 8},         // 0x6B BIT 5, E
+    {&CPU::op_bit, 8, 8},         // 0x6C BIT 5, H
+    {&CPU::op_bit, 8, 8},         // 0x6D BIT 5, L
+    {&CPU::op_bit, 12, 12},       // 0x6E BIT 5, (HL)
+    {&CPU::op_bit, 8, 8},         // 0x6F BIT 5, A
+    {&CPU::op_bit, 8, 8},         // 0x70 BIT 6, B
+    {&CPU::op_bit, 8, 8},         // 0x71 BIT 6, C
+    {&CPU::op_bit, 8, 8},         // 0x72 BIT 6, D
+    {&CPU::op_bit, 8, 8},         // 0x73 BIT 6, E
+    {&CPU::op_bit, 8, 8},         // 0x74 BIT 6, H
+    {&CPU::op_bit, 8, 8},         // 0x75 BIT 6, L
+    {&CPU::op_bit, 12, 12},       // 0x76 BIT 6, (HL)
+    {&CPU::op_bit, 8, 8},         // 0x77 BIT 6, A
+    {&CPU::op_bit, 8, 8},         // 0x78 BIT 7, B
+    {&CPU::op_bit, 8, 8},         // 0x79 BIT 7, C
+    {&CPU::op_bit, 8, 8},         // 0x7A BIT 7, D
+    {&CPU::op_bit, 8, 8},         // 0x7B BIT 7, E
+    {&CPU::op_bit, 8, 8},         // 0x7C BIT 7, H
+    {&CPU::op_bit, 8, 8},         // 0x7D BIT 7, L
+    {&CPU::op_bit, 12, 12},       // 0x7E BIT 7, (HL)
+    {&CPU::op_bit, 8, 8},         // 0x7F BIT 7, A
+    {&CPU::op_res, 8, 8},         // 0x80 RES 0, B
+    {&CPU::op_res, 8, 8},         // 0x81 RES 0, C
+    {&CPU::op_res, 8, 8},         // 0x82 RES 0, D
+    {&CPU::op_res, 8, 8},         // 0x83 RES 0, E
+    {&CPU::op_res, 8, 8},         // 0x84 RES 0, H
+    {&CPU::op_res, 8, 8},         // 0x85 RES 0, L
+    {&CPU::op_res, 16, 16},       // 0x86 RES 0, (HL)
+    {&CPU::op_res, 8, 8},         // 0x87 RES 0, A
+    {&CPU::op_res, 8, 8},         // 0x88 RES 1, B
+    {&CPU::op_res, 8, 8},         // 0x89 RES 1, C
+    {&CPU::op_res, 8, 8},         // 0x8A RES 1, D
+    {&CPU::op_res, 8, 8},         // 0x8B RES 1, E
+    {&CPU::op_res, 8, 8},         // 0x8C RES 1, H
+    {&CPU::op_res, 8, 8},         // 0x8D RES 1, L
+    {&CPU::op_res, 16, 16},       // 0x8E RES 1, (HL)
+    {&CPU::op_res, 8, 8},         // 0x8F RES 1, A
+    {&CPU::op_res, 8, 8},         // 0x90 RES 2, B
+    {&CPU::op_res, 8, 8},         // 0x91 RES 2, C
+    {&CPU::op_res, 8, 8},         // 0x92 RES 2, D
+    {&CPU::op_res, 8, 8},         // 0x93 RES 2, E
+    {&CPU::op_res, 8, 8},         // 0x94 RES 2, H
+    {&CPU::op_res, 8, 8},         // 0x95 RES 2, L
+    {&CPU::op_res, 16, 16},       // 0x96 RES 2, (HL)
+    {&CPU::op_res, 8, 8},         // 0x97 RES 2, A
+    {&CPU::op_res, 8, 8},         // 0x98 RES 3, B
+    {&CPU::op_res, 8, 8},         // 0x99 RES 3, C
+    {&CPU::op_res, 8, 8},         // 0x9A RES 3, D
+    {&CPU::op_res, 8, 8},         // 0x9B RES 3, E
+    {&CPU::op_res, 8, 8},         // 0x9C RES 3, H
+    {&CPU::op_res, 8, 8},         // 0x9D RES 3, L
+    {&CPU::op_res, 16, 16},       // 0x9E RES 3, (HL)
+    {&CPU::op_res, 8, 8},         // 0x9F RES 3, A
+    {&CPU::op_res, 8, 8},         // 0xA0 RES 4, B
+    {&CPU::op_res, 8, 8},         // 0xA1 RES 4, C
+    {&CPU::op_res, 8, 8},         // 0xA2 RES 4, D
+    {&CPU::op_res, 8, 8},         // 0xA3 RES 4, E
+    {&CPU::op_res, 8, 8},         // 0xA4 RES 4, H
+    {&CPU::op_res, 8, 8},         // 0xA5 RES 4, L
+    {&CPU::op_res, 16, 16},       // 0xA6 RES 4, (HL)
+    {&CPU::op_res, 8, 8},         // 0xA7 RES 4, A
+    {&CPU::op_res, 8, 8},         // 0xA8 RES 5, B
+    {&CPU::op_res, 8, 8},         // 0xA9 RES 5, C
+    {&CPU::op_res, 8, 8},         // 0xAA RES 5, D
+    {&CPU::op_res, 8, 8},         // 0xAB RES 5, E
+    {&CPU::op_res, 8, 8},         // 0xAC RES 5, H
+    {&CPU::op_res, 8, 8},         // 0xAD RES 5, L
+    {&CPU::op_res, 16, 16},       // 0xAE RES 5, (HL)
+    {&CPU::op_res, 8, 8},         // 0xAF RES 5, A
+    {&CPU::op_res, 8, 8},         // 0xB0 RES 6, B
+    {&CPU::op_res, 8, 8},         // 0xB1 RES 6, C
+    {&CPU::op_res, 8, 8},         // 0xB2 RES 6, D
+    {&CPU::op_res, 8, 8},         // 0xB3 RES 6, E
+    {&CPU::op_res, 8, 8},         // 0xB4 RES 6, H
+    {&CPU::op_res, 8, 8},         // 0xB5 RES 6, L
+    {&CPU::op_res, 16, 16},       // 0xB6 RES 6, (HL)
+    {&CPU::op_res, 8, 8},         // 0xB7 RES 6, A
+    {&CPU::op_res, 8, 8},         // 0xB8 RES 7, B
+    {&CPU::op_res, 8, 8},         // 0xB9 RES 7, C
+    {&CPU::op_res, 8, 8},         // 0xBA RES 7, D
+    {&CPU::op_res, 8, 8},         // 0xBB RES 7, E
+    {&CPU::op_res, 8, 8},         // 0xBC RES 7, H
+    {&CPU::op_res, 8, 8},         // 0xBD RES 7, L
+    {&CPU::op_res, 16, 16},       // 0xBE RES 7, (HL)
+    {&CPU::op_res, 8, 8},         // 0xBF RES 7, A
+    {&CPU::op_set, 8, 8},         // 0xC0 SET 0, B
+    {&CPU::op_set, 8, 8},         // 0xC1 SET 0, C
+    {&CPU::op_set, 8, 8},         // 0xC2 SET 0, D
+    {&CPU::op_set, 8, 8},         // 0xC3 SET 0, E
+    {&CPU::op_set, 8, 8},         // 0xC4 SET 0, H
+    {&CPU::op_set, 8, 8},         // 0xC5 SET 0, L
+    {&CPU::op_set, 16, 16},       // 0xC6 SET 0, (HL)
+    {&CPU::op_set, 8, 8},         // 0xC7 SET 0, A
+    {&CPU::op_set, 8, 8},         // 0xC8 SET 1, B
+    {&CPU::op_set, 8, 8},         // 0xC9 SET 1, C
+    {&CPU::op_set, 8, 8},         // 0xCA SET 1, D
+    {&CPU::op_set, 8, 8},         // 0xCB SET 1, E
+    {&CPU::op_set, 8, 8},         // 0xCC SET 1, H
+    {&CPU::op_set, 8, 8},         // 0xCD SET 1, L
+    {&CPU::op_set, 16, 16},       // 0xCE SET 1, (HL)
+    {&CPU::op_set, 8, 8},         // 0xCF SET 1, A
+    {&CPU::op_set, 8, 8},         // 0xD0 SET 2, B
+    {&CPU::op_set, 8, 8},         // 0xD1 SET 2, C
+    {&CPU::op_set, 8, 8},         // 0xD2 SET 2, D
+    {&CPU::op_set, 8, 8},         // 0xD3 SET 2, E
+    {&CPU::op_set, 8, 8},         // 0xD4 SET 2, H
+    {&CPU::op_set, 8, 8},         // 0xD5 SET 2, L
+    {&CPU::op_set, 16, 16},       // 0xD6 SET 2, (HL)
+    {&CPU::op_set, 8, 8},         // 0xD7 SET 2, A
+    {&CPU::op_set, 8, 8},         // 0xD8 SET 3, B
+    {&CPU::op_set, 8, 8},         // 0xD9 SET 3, C
+    {&CPU::op_set, 8, 8},         // 0xDA SET 3, D
+    {&CPU::op_set, 8, 8},         // 0xDB SET 3, E
+    {&CPU::op_set, 8, 8},         // 0xDC SET 3, H
+    {&CPU::op_set, 8, 8},         // 0xDD SET 3, L
+    {&CPU::op_set, 16, 16},       // 0xDE SET 3, (HL)
+    {&CPU::op_set, 8, 8},         // 0xDF SET 3, A
+    {&CPU::op_set, 8, 8},         // 0xE0 SET 4, B
+    {&CPU::op_set, 8, 8},         // 0xE1 SET 4, C
+    {&CPU::op_set, 8, 8},         // 0xE2 SET 4, D
+    {&CPU::op_set, 8, 8},         // 0xE3 SET 4, E
+    {&CPU::op_set, 8, 8},         // 0xE4 SET 4, H
+    {&CPU::op_set, 8, 8},         // 0xE5 SET 4, L
+    {&CPU::op_set, 16, 16},       // 0xE6 SET 4, (HL)
+    {&CPU::op_set, 8, 8},         // 0xE7 SET 4, A
+    {&CPU::op_set, 8, 8},         // 0xE8 SET 5, B
+    {&CPU::op_set, 8, 8},         // 0xE9 SET 5, C
+    {&CPU::op_set, 8, 8},         // 0xEA SET 5, D
+    {&CPU::op_set, 8, 8},         // 0xEB SET 5, E
+    {&CPU::op_set, 8, 8},         // 0xEC SET 5, H
+    {&CPU::op_set, 8, 8},         // 0xED SET 5, L
+    {&CPU::op_set, 16, 16},       // 0xEE SET 5, (HL)
+    {&CPU::op_set, 8, 8},         // 0xEF SET 5, A
+    {&CPU::op_set, 8, 8},         // 0xF0 SET 6, B
+    {&CPU::op_set, 8, 8},         // 0xF1 SET 6, C
+    {&CPU::op_set, 8, 8},         // 0xF2 SET 6, D
+    {&CPU::op_set, 8, 8},         // 0xF3 SET 6, E
+    {&CPU::op_set, 8, 8},         // 0xF4 SET 6, H
+    {&CPU::op_set, 8, 8},         // 0xF5 SET 6, L
+    {&CPU::op_set, 16, 16},       // 0xF6 SET 6, (HL)
+    {&CPU::op_set, 8, 8},         // 0xF7 SET 6, A
+    {&CPU::op_set, 8, 8},         // 0xF8 SET 7, B
+    {&CPU::op_set, 8, 8},         // 0xF9 SET 7, C
+    {&CPU::op_set, 8, 8},         // 0xFA SET 7, D
+    {&CPU::op_set, 8, 8},         // 0xFB SET 7, E
+    {&CPU::op_set, 8, 8},         // 0xFC SET 7, H
+    {&CPU::op_set, 8, 8},         // 0xFD SET 7, L
+    {&CPU::op_set, 16, 16},       // 0xFE SET 7, (HL)
+    {&CPU::op_set, 8, 8},         // 0xFF SET 7, A
+};
+
+uint16_t CPU::fetch_op_16bit() {
+    // LSB
+    uint8_t lsb = this->fetch_op();
+    // MSB
+    uint8_t msb = this->fetch_op();
+
+    return (msb << 8) | lsb;
+}
+
+/****    Misc.    ****/
+void CPU::op_nop(uint8_t /*opcode*/) {
+    log_cpu("NOP");
+}
+
+void CPU::op_stop(uint8_t /*opcode*/) {
+    this->stop();
+}
+
+void CPU::op_halt(uint8_t /*opcode*/) {
+    this->halt();
+}
+
+void CPU::op_daa(uint8_t /*opcode*/) {
+    this->daa();
+}
+
+void CPU::op_cpl(uint8_t /*opcode*/) {
+    this->complement();
+}
+
+void CPU::op_ccf(uint8_t /*opcode*/) {
+    this->complement_carry();
+}
+
+void CPU::op_scf(uint8_t /*opcode*/) {
+    this->set_carry();
+}
+
+void CPU::op_di(uint8_t /*opcode*/) {
+    this->disable_interrupts();
+}
+
+void CPU::op_ei(uint8_t /*opcode*/) {
+    this->enable_interrupts();
+}
+
+void CPU::op_undefined(uint8_t opcode) {
+    std::cerr << "Opcode " << static_cast<int>(opcode) << " not implemented" << std::endl;
+}
+
+/****    8-Bit Loads    ****/
+// LD r, r
+void CPU::op_ld_r_r(uint8_t opcode) {
+    this->load(destination_register(opcode), source_register(opcode));
+}
+
+// LD r, n
+void CPU::op_ld_r_n(uint8_t opcode) {
+    uint16_t value = this->fetch_op();
+    this->load(destination_register(opcode), value);
+}
+
+// LD r, (HL)
+void CPU::op_ld_r_hl(uint8_t opcode) {
+    this->load_from_mem(destination_register(opcode), REG_HL);
+}
+
+// LD (HL), r
+void CPU::op_ld_hl_r(uint8_t opcode) {
+    this->load_to_mem(REG_HL, source_register(opcode));
+}
+
+// LD (HL), n
+void CPU::op_ld_hl_n(uint8_t /*opcode*/) {
+    uint16_t value = this->fetch_op();
+    this->load_to_mem(REG_HL, value);
+}
+
+// LD A, (BC)
+// LD A, (DE)
+void CPU::op_ld_a_rr(uint8_t opcode) {
+    this->load_from_mem(REG_A, register_pair(opcode));
+}
+
+// LD (BC), A
+// LD (DE), A
+void CPU::op_ld_rr_a(uint8_t opcode) {
+    this->load_to_mem(register_pair(opcode), REG_A);
+}
+
+// LD A, (nn)
+void CPU::op_ld_a_nn(uint8_t /*opcode*/) {
+    this->load_from_mem(REG_A, this->fetch_op_16bit());
+}
+
+// LD (nn), A
+void CPU::op_ld_nn_a(uint8_t /*opcode*/) {
+    this->load_to_mem(this->fetch_op_16bit(), REG_A);
+}
+
+// LD A, (C)
+void CPU::op_ld_a_c(uint8_t /*opcode*/) {
+    uint16_t address = 0xFF00 + this->read_register(REG_C);
+    this->load_from_mem(REG_A, address);
+}
+
+// LD (C), A
+void CPU::op_ld_c_a(uint8_t /*opcode*/) {
+    uint16_t address = 0xFF00 + this->read_register(REG_C);
+    this->load_to_mem(address, REG_A);
+}
+
+// LDD A, (HL)
+void CPU::op_ldd_a_hl(uint8_t /*opcode*/) {
+    this->load_from_mem(REG_A, REG_HL);
+    this->alu_dec_16bit(REG_HL);
+}
+
+// LDD (HL), A
+void CPU::op_ldd_hl_a(uint8_t /*opcode*/) {
+    this->load_to_mem(REG_HL, REG_A);
+    this->alu_dec_16bit(REG_HL);
+}
+
+// LDI A, (HL)
+void CPU::op_ldi_a_hl(uint8_t /*opcode*/) {
+    this->load_from_mem(REG_A, REG_HL);
+    this->alu_inc_16bit(REG_HL);
+}
+
+// LDI (HL), A
+void CPU::op_ldi_hl_a(uint8_t /*opcode*/) {
+    this->load_to_mem(REG_HL, REG_A);
+    this->alu_inc_16bit(REG_HL);
+}
+
+// LDH (n), A
+void CPU::op_ldh_n_a(uint8_t /*opcode*/) {
+    uint16_t address = 0xFF00 + this->fetch_op();
+    this->load_to_mem(address, REG_A);
+}
+
+// LDH A, (n)
+void CPU::op_ldh_a_n(uint8_t /*opcode*/) {
+    uint16_t address = 0xFF00 + this->fetch_op();
+    this->load_from_mem(REG_A, address);
+}
+
+/****    16-Bit Loads    ****/
+// LD rr, nn
+void CPU::op_ld_rr_nn(uint8_t opcode) {
+    this->load(register_pair(opcode), this->fetch_op_16bit());
+}
+
+// LD SP, HL
+void CPU::op_ld_sp_hl(uint8_t /*opcode*/) {
+    this->load(REG_SP, REG_HL);
+}
+
+// LD HL, SP+e
+void CPU::op_ld_hl_sp_e(uint8_t /*opcode*/) {
+    this->load_HL(this->fetch_op());
+}
+
+// LD (nn), SP
+void CPU::op_ld_nn_sp(uint8_t /*opcode*/) {
+    this->load_to_mem16bit(this->fetch_op_16bit(), REG_SP);
+}
+
+// PUSH rr
+void CPU::op_push(uint8_t opcode) {
+    Registers_t reg = s_stack_register_operands[(opcode >> 4) & 0x03];
+
+    log_cpu("PUSH %s", CPURegisters::to_string(reg));
+
+    this->push_stack(reg);
+}
+
+// POP rr
+void CPU::op_pop(uint8_t opcode) {
+    Registers_t reg = s_stack_register_operands[(opcode >> 4) & 0x03];
+
+    log_cpu("POP %s", CPURegisters::to_string(reg));
+
+    this->pop_stack(reg);
+}
+
+/****    8-Bit ALU    ****/
+// ADD A, r
+// ADD A, (HL)
+void CPU::op_add_r(uint8_t opcode) {
+    this->alu_add(source_register(opcode), false);
+}
+
+// ADD A, n
+void CPU::op_add_n(uint8_t /*opcode*/) {
+    this->alu_add(this->fetch_op(), false);
+}
+
+// ADC A, r
+// ADC A, (HL)
+void CPU::op_adc_r(uint8_t opcode) {
+    this->alu_add(source_register(opcode), true);
+}
+
+// ADC A, n
+void CPU::op_adc_n(uint8_t /*opcode*/) {
+    this->alu_add(this->fetch_op(), true);
+}
+
+// SUB r
+// SUB (HL)
+void CPU::op_sub_r(uint8_t opcode) {
+    this->alu_sub(source_register(opcode), false);
+}
+
+// SUB n
+void CPU::op_sub_n(uint8_t /*opcode*/) {
+    this->alu_sub(this->fetch_op(), false);
+}
+
+// SBC A, r
+// SBC A, (HL)
+void CPU::op_sbc_r(uint8_t opcode) {
+    this->alu_sub(source_register(opcode), true);
+}
+
+// SBC A, n
+void CPU::op_sbc_n(uint8_t /*opcode*/) {
+    this->alu_sub(this->fetch_op(), true);
+}
+
+// AND r
+// AND (HL)
+void CPU::op_and_r(uint8_t opcode) {
+    this->alu_and(source_register(opcode));
+}
+
+// AND n
+void CPU::op_and_n(uint8_t /*opcode*/) {
+    this->alu_and(this->fetch_op());
+}
+
+// OR r
+// OR (HL)
+void CPU::op_or_r(uint8_t opcode) {
+    this->alu_or(source_register(opcode));
+}
+
+// OR n
+void CPU::op_or_n(uint8_t /*opcode*/) {
+    this->alu_or(this->fetch_op());
+}
+
+// XOR r
+// XOR (HL)
+void CPU::op_xor_r(uint8_t opcode) {
+    this->alu_xor(source_register(opcode));
+}
+
+// XOR n
+void CPU::op_xor_n(uint8_t /*opcode*/) {
+    this->alu_xor(this->fetch_op());
+}
+
+// CP r
+// CP (HL)
+void CPU::op_cp_r(uint8_t opcode) {
+    this->alu_cp(source_register(opcode));
+}
+
+// CP n
+void CPU::op_cp_n(uint8_t /*opcode*/) {
+    this->alu_cp(this->fetch_op());
+}
+
+// INC r
+// INC (HL)
+void CPU::op_inc_r(uint8_t opcode) {
+    this->alu_inc(destination_register(opcode));
+}
+
+// DEC r
+// DEC (HL)
+void CPU::op_dec_r(uint8_t opcode) {
+    this->alu_dec(destination_register(opcode));
+}
+
+/****    16-Bit ALU    ****/
+// ADD HL, rr
+void CPU::op_add_hl_rr(uint8_t opcode) {
+    this->alu_add_HL(register_pair(opcode));
+}
+
+// ADD SP, e
+void CPU::op_add_sp_e(uint8_t /*opcode*/) {
+    this->alu_add_SP(this->fetch_op());
+}
+
+// INC rr
+void CPU::op_inc_rr(uint8_t opcode) {
+    this->alu_inc_16bit(register_pair(opcode));
+}
+
+// DEC rr
+void CPU::op_dec_rr(uint8_t opcode) {
+    this->alu_dec_16bit(register_pair(opcode));
+}
+
+/****    Rotates and Shifts    ****/
+// RLCA
+void CPU::op_rlca(uint8_t /*opcode*/) {
+    this->rotate_left_A(false);
+}
+
+// RLA
+void CPU::op_rla(uint8_t /*opcode*/) {
+    this->rotate_left_A(true);
+}
+
+// RRCA
+void CPU::op_rrca(uint8_t /*opcode*/) {
+    this->rotate_right_A(false);
+}
+
+// RRA
+void CPU::op_rra(uint8_t /*opcode*/) {
+    this->rotate_right_A(true);
+}
+
+// RLC r
+void CPU::op_rlc(uint8_t opcode) {
+    this->rotate_left(source_register(opcode), false, true);
+}
+
+// RL r
+void CPU::op_rl(uint8_t opcode) {
+    this->rotate_left(source_register(opcode), true, true);
+}
+
+// RRC r
+void CPU::op_rrc(uint8_t opcode) {
+    this->rotate_right(source_register(opcode), false, true);
+}
+
+// RR r
+void CPU::op_rr(uint8_t opcode) {
+    this->rotate_right(source_register(opcode), true, true);
+}
+
+// SLA r
+void CPU::op_sla(uint8_t opcode) {
+    this->shift_left(source_register(opcode));
+}
+
+// SRA r
+void CPU::op_sra(uint8_t opcode) {
+    this->shift_right(source_register(opcode), true);
+}
+
+// SRL r
+void CPU::op_srl(uint8_t opcode) {
+    this->shift_right(source_register(opcode), false);
+}
+
+// SWAP r
+void CPU::op_swap(uint8_t opcode) {
+    this->swap(source_register(opcode));
+}
+
+/****    Bit Opcodes    ****/
+// BIT b, r
+void CPU::op_bit(uint8_t opcode) {
+    this->test_bit((opcode >> 3) & 0x07, source_register(opcode));
+}
+
+// SET b, r
+void CPU::op_set(uint8_t opcode) {
+    this->set_bit((opcode >> 3) & 0x07, source_register(opcode));
+}
+
+// RES b, r
+void CPU::op_res(uint8_t opcode) {
+    this->reset_bit((opcode >> 3) & 0x07, source_register(opcode));
+}
+
+/****    Jumps    ****/
+// JP nn
+void CPU::op_jp(uint8_t /*opcode*/) {
+    uint16_t address = this->fetch_op_16bit();
+
+    log_cpu("JP %X", address);
+
+    this->jump(address);
+}
+
+// JP cc, nn
+void CPU::op_jp_cc(uint8_t opcode) {
+    uint16_t address = this->fetch_op_16bit();
+    int cc = condition(opcode);
+
+    log_cpu("JP %s %X", s_condition_names[cc], address);
+
+    this->jump_conditional(address, s_condition_flags[cc], s_condition_set[cc]);
+}
+
+// JP (HL)
+void CPU::op_jp_hl(uint8_t /*opcode*/) {
+    log_cpu("JP (%X)", this->read_register(REG_HL));
+
+    this->jump_hl();
+}
+
+// JR n
+void CPU::op_jr(uint8_t /*opcode*/) {
+    uint8_t offset = this->fetch_op();
+
+    log_cpu("JR %d", static_cast<int8_t>(offset));
+
+    this->jump_add(offset);
+}
+
+// JR cc, n
+void CPU::op_jr_cc(uint8_t opcode) {
+    uint8_t offset = this->fetch_op();
+    int cc = condition(opcode);
+
+    log_cpu("JR %s %d", s_condition_names[cc], static_cast<int8_t>(offset));
+
+    this->jump_add_conditional(offset, s_condition_flags[cc], s_condition_set[cc]);
+}
+
+/****    Calls    ****/
+// CALL nn
+void CPU::op_call(uint8_t /*opcode*/) {
+    uint16_t address = this->fetch_op_16bit();
+
+    log_cpu("CALL %X", address);
+
+    this->call(address);
+}
+
+// CALL cc, nn
+void CPU::op_call_cc(uint8_t opcode) {
+    uint16_t address = this->fetch_op_16bit();
+    int cc = condition(opcode);
+
+    log_cpu("CALL %s %X", s_condition_names[cc], address);
+
+    this->call(address, s_condition_flags[cc], s_condition_set[cc]);
+}
+
+/****    Restarts    ****/
+// RST n
+void CPU::op_rst(uint8_t opcode) {
+    uint8_t address = opcode & 0x38;
+
+    log_cpu("RST %02X", address);
+
+    this->restart(address);
+}
+
+/****    Returns    ****/
+// RET
+void CPU::op_ret(uint8_t /*opcode*/) {
+    log_cpu("RET");
+
+    this->ret();
+}
+
+// RET cc
+void CPU::op_ret_cc(uint8_t opcode) {
+    int cc = condition(opcode);
+
+    log_cpu("RET %s", s_condition_names[cc]);
+
+    this->ret(s_condition_flags[cc], s_condition_set[cc]);
+}
+
+// RETI
+void CPU::op_reti(uint8_t /*opcode*/) {
+    log_cpu("RETI");
+
+    this->ret_enable_interrupts();
+}
@@ -2,7 +2,7 @@
 
 // JP nn
 void CPU::jump(uint16_t value) {
-    this->write_register(REG_PC, value);
+    m_registers.write_PC(value);
 }
 
 // JP cc, nn
@@ -10,35 +10,40 @@ void CPU::jump_conditional(uint16_t value, CPUFlag_t flag, bool set) {
     bool flag_set = this->read_flag_register(flag);
 
     if (!(flag_set ^ set)) {
-        this->write_register(REG_PC, value);
+        m_registers.write_PC(value);
+        m_branch_taken = true;
     }
 }
 
 // JP (HL)
 void CPU::jump_hl() {
-    uint16_t value = this->read_register(REG_HL);
+    uint16_t value = m_registers.read_HL();
 
     
     log_cpu("JP (HL)");
     
 
-    this->write_register(REG_PC, value);
+    m_registers.write_PC(value);
 }
 
 // JR n
 void CPU::jump_add(int8_t value) {
-    uint16_t pc = this->read_register(REG_PC);
+    uint16_t pc = m_registers.read_PC();
 
-    this->write_register(REG_PC, pc + value);
+    m_registers.write_PC(pc + value);
 }
 
 // JR cc, n
 void CPU::jump_add_conditional(int8_t value, CPUFlag_t flag, bool set) {
-    uint16_t pc = this->read_register(REG_PC);
+    uint16_t pc = m_registers.read_PC();
     bool flag_set = this->read_flag_register(flag);
 
     if (!(flag_set ^ set)) {
-        this->write_register(REG_PC, pc + value);
+        m_registers.write_PC(pc + value);
+        m_branch_taken = true;
+
+        // Short enough to be a polling loop, see fast_forward
+        m_idle_loop_candidate = (value < 0 && value >= -MAX_IDLE_LOOP_BYTES);
     }
 }
 
@@ -50,11 +55,11 @@ void CPU::restart(uint8_t n) {
 }
 
 void CPU::call(uint16_t nn) {
-    uint16_t PC = this->read_register(REG_PC);
-    this->write_register(REG_PC, PC);
+    uint16_t PC = m_registers.read_PC();
+    m_registers.write_PC(PC);
     // Push current address to stack
     this->push_stack(REG_PC);
-    this->write_register(REG_PC, PC);
+    m_registers.write_PC(PC);
 
     // Jump to address nn
     this->jump(nn);
@@ -62,14 +67,15 @@ void CPU::call(uint16_t nn) {
 
 void CPU::call(uint16_t nn, CPUFlag_t flag, bool is_set) {
     if (!(this->read_flag_register(flag) ^ is_set)) {
-        uint16_t PC = this->read_register(REG_PC);
-        this->write_register(REG_PC, PC);
+        uint16_t PC = m_registers.read_PC();
+        m_registers.write_PC(PC);
         // Push current address to stack
         this->push_stack(REG_PC);
-        this->write_register(REG_PC, PC);
+        m_registers.write_PC(PC);
 
         // Jump to address nn
         this->jump(nn);
+        m_branch_taken = true;
     }
 }
 
@@ -82,6 +88,7 @@ void CPU::ret() {
 void CPU::ret(CPUFlag_t flag, bool is_set) {
     if (!(this->read_flag_register(flag) ^ is_set)) {
         this->pop_stack(REG_PC);
+        m_branch_taken = true;
     }
 }
 
@@ -1,4 +1,5 @@
 #include "cpu.h"
+#include "cpu_alu_tables.h"
 
 
 void CPU::swap(Registers_t reg) {
@@ -32,7 +33,7 @@ void CPU::swap(Registers_t reg) {
 }
 
 void CPU::complement() {
-    uint8_t val = this->read_register(REG_A);
+    uint8_t val = m_registers.read_A();
     uint8_t result = ~val;
 
     
@@ -42,7 +43,7 @@ void CPU::complement() {
     this->set_flag_register(SUBTRACT_FLAG, true);
     this->set_flag_register(HALF_CARRY_FLAG, true);
 
-    this->write_register(REG_A, result);
+    m_registers.write_A(result);
 }
 
 void CPU::complement_carry() {
@@ -105,32 +106,8 @@ void CPU::disable_interrupts() {
 void CPU::daa() {
     log_cpu("DAA");
 
-    bool subtract = this->read_flag_register(SUBTRACT_FLAG);
-    bool carry = this->read_flag_register(CARRY_FLAG);
-    bool half_carry = this->read_flag_register(HALF_CARRY_FLAG);
-
-    uint8_t A = this->read_register(REG_A);
+    uint16_t result = alu_tables.daa(m_registers.read_A(), this->read_register(REG_F));
 
-    if (subtract) {
-        if (carry) {
-            A -= 0x60;
-        }
-        if (half_carry) {
-            A -= 0x06;
-        }
-    }
-    else {
-        if (carry || A > 0x99) {
-            carry = true;
-            A += 0x60;
-        }
-        if (half_carry || (A & 0x0F) > 0x09) {
-            A += 0x06;
-        }
-    }
-
-    this->write_register(REG_A, A);
-    this->set_flag_register(HALF_CARRY_FLAG, false);
-    this->set_flag_register(CARRY_FLAG, carry);
-    this->set_flag_register(ZERO_FLAG, (A == 0));
+    m_registers.write_A(result >> 8);
+    this->write_register(REG_F, result & 0xFF);
 }
@@ -1,113 +1,41 @@
 #include "cpu_registers.h"
 
 
-CPURegisters::CPURegisters():
-m_A(0x01),
-m_F(0xB0),
-m_B(0x00),
-m_C(0x13),
-m_D(0x00),
-m_E(0xD8),
-m_H(0x01),
-m_L(0x4D),
-m_PC(0x0100),
-m_SP(0xFFFE)
-{
+// Pair holding each register in Registers_t order: A, F, B, C, D, E, H, L, AF, BC, DE, HL, PC, SP
+const uint8_t CPURegisters::s_pair[] = {
+    PAIR_AF, PAIR_AF, PAIR_BC, PAIR_BC, PAIR_DE, PAIR_DE, PAIR_HL, PAIR_HL,
+    PAIR_AF, PAIR_BC, PAIR_DE, PAIR_HL, PAIR_PC, PAIR_SP
+};
 
-}
+// 8-bit registers in the high byte of their pair are shifted down by 8
+const uint8_t CPURegisters::s_shift[] = {
+    8, 0, 8, 0, 8, 0, 8, 0,
+    0, 0, 0, 0, 0, 0
+};
 
-CPURegisters::~CPURegisters() {
+const uint16_t CPURegisters::s_read_mask[] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF
+};
 
-}
+// The lower 4 bits of F always read as 0
+const uint16_t CPURegisters::s_write_mask[] = {
+    0xFF, 0xF0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFFF0, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF
+};
 
-void CPURegisters::write_register(Registers_t reg, uint16_t data) {
-    switch (reg) {
-        case REG_AF:
-            m_A = data >> 8;
-            m_F = data & 0xF0;
-            break;
-        case REG_BC:
-            m_B = data >> 8;
-            m_C = data & 0xFF;
-            break;
-        case REG_DE:
-            m_D = data >> 8;
-            m_E = data & 0xFF;
-            break;
-        case REG_HL:
-            m_H = data >> 8;
-            m_L = data & 0xFF;
-            break;
-        case REG_PC:
-            m_PC = data;
-            break;
-        case REG_SP:
-            m_SP = data;
-            break;
-        case REG_A:
-            m_A = data;
-            break;
-        case REG_F:
-            m_F = (data & 0xF0);
-            break;
-        case REG_B:
-            m_B = data;
-            break;
-        case REG_C:
-            m_C = data;
-            break;
-        case REG_D:
-            m_D = data;
-            break;
-        case REG_E:
-            m_E = data;
-            break;
-        case REG_H:
-            m_H = data;
-            break;
-        case REG_L:
-            m_L = data;
-            break;
-        default:
-            std::cerr << "Error: Register does not exist" << std::endl;
-            throw new std::exception;
-    }
+
+CPURegisters::CPURegisters() {
+    m_pairs[PAIR_AF] = 0x01B0;
+    m_pairs[PAIR_BC] = 0x0013;
+    m_pairs[PAIR_DE] = 0x00D8;
+    m_pairs[PAIR_HL] = 0x014D;
+    m_pairs[PAIR_SP] = 0xFFFE;
+    m_pairs[PAIR_PC] = 0x0100;
 }
 
-uint16_t CPURegisters::read_register(Registers_t reg) {
-    switch (reg) {
-        case REG_AF:
-            return (m_A << 8) | (m_F);
-        case REG_BC:
-            return (m_B << 8) | (m_C);
-        case REG_DE:
-            return (m_D << 8) | (m_E);
-        case REG_HL:
-            return (m_H << 8) | (m_L);
-        case REG_PC:
-            return m_PC;
-        case REG_SP:
-            return m_SP;
-        case REG_A:
-            return m_A;
-        case REG_F:
-            return m_F;
-        case REG_B:
-            return m_B;
-        case REG_C:
-            return m_C;
-        case REG_D:
-            return m_D;
-        case REG_E:
-            return m_E;
-        case REG_H:
-            return m_H;
-        case REG_L:
-            return m_L;
-        default:
-            std::cerr << "Error: Register does not exist" << std::endl;
-            throw new std::exception;
-    }
+CPURegisters::~CPURegisters() {
+
 }
 
 const char *CPURegisters::to_string(Registers_t reg) {
@@ -130,3 +58,14 @@ const char *CPURegisters::to_string(Registers_t reg) {
 
     return "";
 }
+
+void CPURegisters::save_state(StateWriter &writer) const {
+    writer.write(m_pairs);
+}
+
+void CPURegisters::load_state(StateReader &reader) {
+    reader.read(m_pairs);
+
+    // F only has the upper four bits
+    m_pairs[PAIR_AF] &= 0xFFF0;
+}
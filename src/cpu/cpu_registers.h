@@ -4,6 +4,8 @@
 #include <exception>
 #include <string>
 
+#include "../utils/state_buffer.h"
+
 enum Registers_t {
     REG_A,
     REG_F,
@@ -21,25 +23,59 @@ enum Registers_t {
     REG_SP
 };
 
+// 16-bit register pairs, 8-bit registers are stored as the high and low byte of a pair
+typedef enum RegisterPair {
+    PAIR_AF,
+    PAIR_BC,
+    PAIR_DE,
+    PAIR_HL,
+    PAIR_SP,
+    PAIR_PC,
+    NUM_REGISTER_PAIRS
+} RegisterPair_t;
+
 class CPURegisters {
     public:
         CPURegisters();
         virtual ~CPURegisters();
 
         void write_register(Registers_t, uint16_t);
-        uint16_t read_register(Registers_t);
+        uint16_t read_register(Registers_t) const;
+
+        // Fixed accessors for the hot paths
+        uint8_t read_A() const { return m_pairs[PAIR_AF] >> 8; }
+        void write_A(uint8_t data) { m_pairs[PAIR_AF] = (data << 8) | (m_pairs[PAIR_AF] & 0x00FF); }
+        uint8_t read_F() const { return m_pairs[PAIR_AF] & 0xFF; }
+        void write_F(uint8_t data) { m_pairs[PAIR_AF] = (m_pairs[PAIR_AF] & 0xFF00) | (data & 0xF0); }
+        uint16_t read_HL() const { return m_pairs[PAIR_HL]; }
+        void write_HL(uint16_t data) { m_pairs[PAIR_HL] = data; }
+        uint16_t read_SP() const { return m_pairs[PAIR_SP]; }
+        void write_SP(uint16_t data) { m_pairs[PAIR_SP] = data; }
+        uint16_t read_PC() const { return m_pairs[PAIR_PC]; }
+        void write_PC(uint16_t data) { m_pairs[PAIR_PC] = data; }
 
         static const char *to_string(Registers_t);
 
+        void save_state(StateWriter &) const;
+        void load_state(StateReader &);
+
     private:
-        uint8_t m_A;
-        uint8_t m_F;
-        uint8_t m_B;
-        uint8_t m_C;
-        uint8_t m_D;
-        uint8_t m_E;
-        uint8_t m_H;
-        uint8_t m_L;
-        uint16_t m_PC;
-        uint16_t m_SP;
+        uint16_t m_pairs[NUM_REGISTER_PAIRS];
+
+        // Per register lookup tables indexed by Registers_t
+        static const uint8_t s_pair[];
+        static const uint8_t s_shift[];
+        static const uint16_t s_read_mask[];
+        static const uint16_t s_write_mask[];
 };
+
+inline uint16_t CPURegisters::read_register(Registers_t reg) const {
+    return (m_pairs[s_pair[reg]] >> s_shift[reg]) & s_read_mask[reg];
+}
+
+inline void CPURegisters::write_register(Registers_t reg, uint16_t data) {
+    uint16_t &pair = m_pairs[s_pair[reg]];
+    uint16_t keep = ~(s_read_mask[reg] << s_shift[reg]);
+
+    pair = (pair & keep) | ((data & s_write_mask[reg]) << s_shift[reg]);
+}
@@ -16,13 +16,9 @@ void CPU::rotate_left(Registers_t reg, bool use_carry, bool set_zero) {
     uint8_t result = val << 1;
     bool bit_7 = (val & 0x80) == 0x80;
 
-    // Set flags
-    this->set_flag_register(SUBTRACT_FLAG, false);
-    this->set_flag_register(HALF_CARRY_FLAG, false);
-
     // RLA
     if (use_carry)  {
-        bool old_bit_7 = this->read_flag_register(CARRY_FLAG);
+        bool old_bit_7 = this->carry_flag();
         
         if (reg == REG_A && !set_zero) {
             log_cpu("RLA");
@@ -59,13 +55,13 @@ void CPU::rotate_left(Registers_t reg, bool use_carry, bool set_zero) {
         this->write_register(reg, result);
     }
 
-    if (set_zero) {
-        this->set_flag_register(ZERO_FLAG, (result == 0));
-    } else {
-        this->set_flag_register(ZERO_FLAG, false);
+    // Set flags, N and H are always reset
+    uint8_t flags = (bit_7) ? CARRY_FLAG : 0;
+    if (set_zero && result == 0) {
+        flags |= ZERO_FLAG;
     }
 
-    this->set_flag_register(CARRY_FLAG, bit_7);
+    this->write_register(REG_F, flags);
 }
 
 void CPU::rotate_right_A(bool use_carry) {
@@ -84,13 +80,9 @@ void CPU::rotate_right(Registers_t reg, bool use_carry, bool set_zero) {
     uint8_t result = val >> 1;
     bool bit_0 = (val & 0x01) == 0x01;
 
-    // Set flags
-    this->set_flag_register(SUBTRACT_FLAG, false);
-    this->set_flag_register(HALF_CARRY_FLAG, false);
-
     // RRA
     if (use_carry)  {
-        bool old_bit_0 = this->read_flag_register(CARRY_FLAG);
+        bool old_bit_0 = this->carry_flag();
         if (old_bit_0) {
             result |= 0x80;
         }
@@ -129,13 +121,13 @@ void CPU::rotate_right(Registers_t reg, bool use_carry, bool set_zero) {
         this->write_register(reg, result);
     }
 
-    if (set_zero) {
-        this->set_flag_register(ZERO_FLAG, (result == 0));
-    } else {
-        this->set_flag_register(ZERO_FLAG, false);
+    // Set flags, N and H are always reset
+    uint8_t flags = (bit_0) ? CARRY_FLAG : 0;
+    if (set_zero && result == 0) {
+        flags |= ZERO_FLAG;
     }
 
-    this->set_flag_register(CARRY_FLAG, bit_0);
+    this->write_register(REG_F, flags);
 }
 
 void CPU::shift_left(Registers_t reg) {
@@ -153,11 +145,6 @@ void CPU::shift_left(Registers_t reg) {
 
     log_cpu("SLA %s", CPURegisters::to_string(reg));
 
-    // Set flags
-    this->set_flag_register(ZERO_FLAG, (result == 0));
-    this->set_flag_register(SUBTRACT_FLAG, false);
-    this->set_flag_register(HALF_CARRY_FLAG, false);
-
     if (reg == REG_HL) {
         this->write_memory(result);
     }
@@ -165,7 +152,13 @@ void CPU::shift_left(Registers_t reg) {
         this->write_register(reg, result);
     }
 
-    this->set_flag_register(CARRY_FLAG, bit_7);
+    // Set flags, N and H are always reset
+    uint8_t flags = (bit_7) ? CARRY_FLAG : 0;
+    if (result == 0) {
+        flags |= ZERO_FLAG;
+    }
+
+    this->write_register(REG_F, flags);
 }
 
 void CPU::shift_right(Registers_t reg, bool keep_msb) {
@@ -194,11 +187,6 @@ void CPU::shift_right(Registers_t reg, bool keep_msb) {
         log_cpu("SRL %s", CPURegisters::to_string(reg));
     }
 
-    // Set flags
-    this->set_flag_register(ZERO_FLAG, (result == 0));
-    this->set_flag_register(SUBTRACT_FLAG, false);
-    this->set_flag_register(HALF_CARRY_FLAG, false);
-
     if (reg == REG_HL) {
         this->write_memory(result);
     }
@@ -206,5 +194,11 @@ void CPU::shift_right(Registers_t reg, bool keep_msb) {
         this->write_register(reg, result);
     }
 
-    this->set_flag_register(CARRY_FLAG, bit_0);
+    // Set flags, N and H are always reset
+    uint8_t flags = (bit_0) ? CARRY_FLAG : 0;
+    if (result == 0) {
+        flags |= ZERO_FLAG;
+    }
+
+    this->write_register(REG_F, flags);
 }
\ No newline at end of file
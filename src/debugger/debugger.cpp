@@ -136,8 +136,9 @@ bool Debugger::check_breakpoints(uint16_t val, BreakpointType_t type) {
 }
 
 void Debugger::print_reg(const std::string &reg_str) {
-    Registers_t reg = register_from_string(reg_str);
-    log_debug("%s = 0x%X", reg_str.c_str(), m_cpu.read_register(reg));
+    // Only read by the log call, which GAMEBOY_DISABLE_LOGGING compiles out
+    (void)reg_str;
+    log_debug("%s = 0x%X", reg_str.c_str(), m_cpu.read_register(register_from_string(reg_str)));
 }
 
 void Debugger::help() {
@@ -0,0 +1,119 @@
+#include "disassembler.h"
+
+
+static const char *s_mnemonics[256] = {
+    "NOP", "LD BC, d16", "LD (BC), A", "INC BC",
+    "INC B", "DEC B", "LD B, d8", "RLCA",
+    "LD (a16), SP", "ADD HL, BC", "LD A, (BC)", "DEC BC",
+    "INC C", "DEC C", "LD C, d8", "RRCA",
+    "STOP", "LD DE, d16", "LD (DE), A", "INC DE",
+    "INC D", "DEC D", "LD D, d8", "RLA",
+    "JR r8", "ADD HL, DE", "LD A, (DE)", "DEC DE",
+    "INC E", "DEC E", "LD E, d8", "RRA",
+    "JR NZ r8", "LD HL, d16", "LD (HL+), A", "INC HL",
+    "INC H", "DEC H", "LD H, d8", "DAA",
+    "JR Z r8", "ADD HL, HL", "LD A, (HL+)", "DEC HL",
+    "INC L", "DEC L", "LD L, d8", "CPL",
+    "JR NC r8", "LD SP, d16", "LD (HL-), A", "INC SP",
+    "INC (HL)", "DEC (HL)", "LD (HL), d8", "SCF",
+    "JR C r8", "ADD HL, SP", "LD A, (HL-)", "DEC SP",
+    "INC A", "DEC A", "LD A, d8", "CCF",
+    "LD B, B", "LD B, C", "LD B, D", "LD B, E",
+    "LD B, H", "LD B, L", "LD B, (HL)", "LD B, A",
+    "LD C, B", "LD C, C", "LD C, D", "LD C, E",
+    "LD C, H", "LD C, L", "LD C, (HL)", "LD C, A",
+    "LD D, B", "LD D, C", "LD D, D", "LD D, E",
+    "LD D, H", "LD D, L", "LD D, (HL)", "LD D, A",
+    "LD E, B", "LD E, C", "LD E, D", "LD E, E",
+    "LD E, H", "LD E, L", "LD E, (HL)", "LD E, A",
+    "LD H, B", "LD H, C", "LD H, D", "LD H, E",
+    "LD H, H", "LD H, L", "LD H, (HL)", "LD H, A",
+    "LD L, B", "LD L, C", "LD L, D", "LD L, E",
+    "LD L, H", "LD L, L", "LD L, (HL)", "LD L, A",
+    "LD (HL), B", "LD (HL), C", "LD (HL), D", "LD (HL), E",
+    "LD (HL), H", "LD (HL), L", "HALT", "LD (HL), A",
+    "LD A, B", "LD A, C", "LD A, D", "LD A, E",
+    "LD A, H", "LD A, L", "LD A, (HL)", "LD A, A",
+    "ADD A, B", "ADD A, C", "ADD A, D", "ADD A, E",
+    "ADD A, H", "ADD A, L", "ADD A, (HL)", "ADD A, A",
+    "ADC A, B", "ADC A, C", "ADC A, D", "ADC A, E",
+    "ADC A, H", "ADC A, L", "ADC A, (HL)", "ADC A, A",
+    "SUB A, B", "SUB A, C", "SUB A, D", "SUB A, E",
+    "SUB A, H", "SUB A, L", "SUB A, (HL)", "SUB A, A",
+    "SBC A, B", "SBC A, C", "SBC A, D", "SBC A, E",
+    "SBC A, H", "SBC A, L", "SBC A, (HL)", "SBC A, A",
+    "AND A, B", "AND A, C", "AND A, D", "AND A, E",
+    "AND A, H", "AND A, L", "AND A, (HL)", "AND A, A",
+    "XOR A, B", "XOR A, C", "XOR A, D", "XOR A, E",
+    "XOR A, H", "XOR A, L", "XOR A, (HL)", "XOR A, A",
+    "OR A, B", "OR A, C", "OR A, D", "OR A, E",
+    "OR A, H", "OR A, L", "OR A, (HL)", "OR A, A",
+    "CP A, B", "CP A, C", "CP A, D", "CP A, E",
+    "CP A, H", "CP A, L", "CP A, (HL)", "CP A, A",
+    "RET NZ", "POP BC", "JP NZ a16", "JP a16",
+    "CALL NZ a16", "PUSH BC", "ADD A, d8", "RST 00",
+    "RET Z", "RET", "JP Z a16", "PREFIX CB",
+    "CALL Z a16", "CALL a16", "ADC A, d8", "RST 08",
+    "RET NC", "POP DE", "JP NC a16", "ILLEGAL",
+    "CALL NC a16", "PUSH DE", "SUB A, d8", "RST 10",
+    "RET C", "RETI", "JP C a16", "ILLEGAL",
+    "CALL C a16", "ILLEGAL", "SBC A, d8", "RST 18",
+    "LDH (a8), A", "POP HL", "LD (C), A", "ILLEGAL",
+    "ILLEGAL", "PUSH HL", "AND A, d8", "RST 20",
+    "ADD SP, r8", "JP (HL)", "LD (a16), A", "ILLEGAL",
+    "ILLEGAL", "ILLEGAL", "XOR A, d8", "RST 28",
+    "LDH A, (a8)", "POP AF", "LD A, (C)", "DI",
+    "ILLEGAL", "PUSH AF", "OR A, d8", "RST 30",
+    "LDHL SP, r8", "LD SP, HL", "LD A, (a16)", "EI",
+    "ILLEGAL", "ILLEGAL", "CP A, d8", "RST 38",
+};
+
+static const char *s_cb_operations[8] = {"RLC", "RRC", "RL", "RR", "SLA", "SRA", "SWAP", "SRL"};
+static const char *s_cb_bit_operations[4] = {"", "BIT", "RES", "SET"};
+static const char *s_cb_registers[8] = {"B", "C", "D", "E", "H", "L", "(HL)", "A"};
+
+
+// Replace the first operand placeholder of a mnemonic with the immediate bytes
+static std::string format_operands(const std::string &mnemonic, uint8_t low, uint8_t high) {
+    char buffer[16];
+    size_t position;
+
+    if ((position = mnemonic.find("d16")) != std::string::npos || (position = mnemonic.find("a16")) != std::string::npos) {
+        snprintf(buffer, sizeof(buffer), "%X", (high << 8) | low);
+        return mnemonic.substr(0, position) + buffer + mnemonic.substr(position + 3);
+    }
+    if ((position = mnemonic.find("d8")) != std::string::npos) {
+        snprintf(buffer, sizeof(buffer), "%X", low);
+        return mnemonic.substr(0, position) + buffer + mnemonic.substr(position + 2);
+    }
+    if ((position = mnemonic.find("a8")) != std::string::npos) {
+        snprintf(buffer, sizeof(buffer), "%X", 0xFF00 | low);
+        return mnemonic.substr(0, position) + buffer + mnemonic.substr(position + 2);
+    }
+    if ((position = mnemonic.find("r8")) != std::string::npos) {
+        snprintf(buffer, sizeof(buffer), "%d", (int8_t)low);
+        return mnemonic.substr(0, position) + buffer + mnemonic.substr(position + 2);
+    }
+
+    return mnemonic;
+}
+
+std::string disassemble(uint8_t opcode, uint8_t operand_1, uint8_t operand_2) {
+    if (opcode != 0xCB) {
+        return format_operands(s_mnemonics[opcode], operand_1, operand_2);
+    }
+
+    // CB prefixed, the first operand byte is the second opcode
+    uint8_t cb_opcode = operand_1;
+    const char *reg = s_cb_registers[cb_opcode & 0x7];
+    char buffer[16];
+
+    if (cb_opcode < 0x40) {
+        snprintf(buffer, sizeof(buffer), "%s %s", s_cb_operations[cb_opcode >> 3], reg);
+    }
+    else {
+        snprintf(buffer, sizeof(buffer), "%s %X, %s", s_cb_bit_operations[cb_opcode >> 6], (cb_opcode >> 3) & 0x7, reg);
+    }
+
+    return std::string(buffer);
+}
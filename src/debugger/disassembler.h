@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+
+
+// Mnemonic for an instruction given its opcode and the two bytes that follow it
+std::string disassemble(uint8_t, uint8_t, uint8_t);
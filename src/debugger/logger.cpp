@@ -5,28 +5,8 @@ Logger logger;
 
 
 void Logger::log(LogType_t log_type, bool newline, const char *fmt, ...) {
-    switch (log_type) {
-        case LOG_WARN:
-            if (!m_warn_logging_enabled) return;
-            break;
-        case LOG_DEBUG:
-            if (!m_debug_logging_enabled) return;
-            break;
-        case LOG_CPU:
-            if (!m_cpu_logging_enabled) return;
-            break;
-        case LOG_INTERRUPTS:
-            if (!m_interrupt_logging_enabled) return;
-            break;
-        case LOG_IO:
-            if (!m_io_logging_enabled) return;
-            break;
-        case LOG_VIDEO:
-            if (!m_video_logging_enabled) return;
-            break;
-        case LOG_MEMORY:
-            if (!m_memory_logging_enabled) return;
-            break;
+    if (!this->is_logging_enabled(log_type)) {
+        return;
     }
 
     va_list args;
@@ -49,27 +29,5 @@ std::string Logger::str_format(const char *fmt, va_list args) {
 }
 
 void Logger::enable_logging(LogType_t log_type, bool enable) {
-    switch (log_type) {
-        case LOG_WARN:
-            m_warn_logging_enabled = enable;
-            break;
-        case LOG_DEBUG:
-            m_debug_logging_enabled = enable;
-            break;
-        case LOG_CPU:
-            m_cpu_logging_enabled = enable;
-            break;
-        case LOG_INTERRUPTS:
-            m_interrupt_logging_enabled = enable;
-            break;
-        case LOG_IO:
-            m_io_logging_enabled = enable;
-            break;
-        case LOG_VIDEO:
-            m_video_logging_enabled = enable;
-            break;
-        case LOG_MEMORY:
-            m_memory_logging_enabled = enable;
-            break;
-    }
+    m_logging_enabled[log_type] = enable;
 }
@@ -12,7 +12,8 @@ typedef enum LogType {
     LOG_INTERRUPTS,
     LOG_IO,
     LOG_VIDEO,
-    LOG_MEMORY
+    LOG_MEMORY,
+    NUM_LOG_TYPES
 } LogType_t;
 
 
@@ -23,37 +24,58 @@ class Logger {
         void log(LogType_t, bool, const char *, ...);
 
         void enable_logging(LogType_t, bool);
+        bool is_logging_enabled(LogType_t) const;
 
         std::string str_format(const char *, va_list);
     
     private:
-        bool m_warn_logging_enabled = false;
-        bool m_debug_logging_enabled = false;
-        bool m_cpu_logging_enabled = false;
-        bool m_interrupt_logging_enabled = false;
-        bool m_io_logging_enabled = false;
-        bool m_video_logging_enabled = false;
-        bool m_memory_logging_enabled = false;
+        bool m_logging_enabled[NUM_LOG_TYPES] = {};
 };
 
 
 extern Logger logger;
 
 
-#define log_warn(...) logger.log(LOG_WARN, true, ##__VA_ARGS__);
-#define log_warn_no_new_line(...) logger.log(LOG_WARN, false, ##__VA_ARGS__);
-#define log_debug(...) logger.log(LOG_DEBUG, true, ##__VA_ARGS__);
-#define log_debug_no_new_line(...) logger.log(LOG_DEBUG, false, ##__VA_ARGS__);
-#define log_cpu(...) logger.log(LOG_CPU, true, ##__VA_ARGS__);
-#define log_cpu_no_new_line(...) logger.log(LOG_CPU, false, ##__VA_ARGS__);
-#define log_interrupts(...) logger.log(LOG_INTERRUPTS, true, ##__VA_ARGS__);
-#define log_interrupts_no_new_line(...) logger.log(LOG_INTERRUPTS, false, ##__VA_ARGS__);
-#define log_io(...) logger.log(LOG_IO, true, ##__VA_ARGS__);
-#define log_io_no_new_line(...) logger.log(LOG_IO, false, ##__VA_ARGS__);
-#define log_video(...) logger.log(LOG_VIDEO, true, ##__VA_ARGS__);
-#define log_video_no_new_line(...) logger.log(LOG_VIDEO, false, ##__VA_ARGS__);
-#define log_memory(...) logger.log(LOG_MEMORY, true, ##__VA_ARGS__);
-#define log_memory_no_new_line(...) logger.log(LOG_MEMORY, false, ##__VA_ARGS__);
+inline bool Logger::is_logging_enabled(LogType_t log_type) const {
+    return m_logging_enabled[log_type];
+}
+
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LOG_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define LOG_UNLIKELY(x) (x)
+#endif
+
+// Building with GAMEBOY_DISABLE_LOGGING removes every call and its arguments.
+// Otherwise the enabled check is inlined so disabled categories cost one load
+// and a not-taken branch, and the arguments are only evaluated when logging.
+#ifdef GAMEBOY_DISABLE_LOGGING
+#define log_message(type, newline, ...) do { } while (0)
+#else
+#define log_message(type, newline, ...) \
+    do { \
+        if (LOG_UNLIKELY(logger.is_logging_enabled(type))) { \
+            logger.log(type, newline, ##__VA_ARGS__); \
+        } \
+    } while (0)
+#endif
+
+
+#define log_warn(...) log_message(LOG_WARN, true, ##__VA_ARGS__)
+#define log_warn_no_new_line(...) log_message(LOG_WARN, false, ##__VA_ARGS__)
+#define log_debug(...) log_message(LOG_DEBUG, true, ##__VA_ARGS__)
+#define log_debug_no_new_line(...) log_message(LOG_DEBUG, false, ##__VA_ARGS__)
+#define log_cpu(...) log_message(LOG_CPU, true, ##__VA_ARGS__)
+#define log_cpu_no_new_line(...) log_message(LOG_CPU, false, ##__VA_ARGS__)
+#define log_interrupts(...) log_message(LOG_INTERRUPTS, true, ##__VA_ARGS__)
+#define log_interrupts_no_new_line(...) log_message(LOG_INTERRUPTS, false, ##__VA_ARGS__)
+#define log_io(...) log_message(LOG_IO, true, ##__VA_ARGS__)
+#define log_io_no_new_line(...) log_message(LOG_IO, false, ##__VA_ARGS__)
+#define log_video(...) log_message(LOG_VIDEO, true, ##__VA_ARGS__)
+#define log_video_no_new_line(...) log_message(LOG_VIDEO, false, ##__VA_ARGS__)
+#define log_memory(...) log_message(LOG_MEMORY, true, ##__VA_ARGS__)
+#define log_memory_no_new_line(...) log_message(LOG_MEMORY, false, ##__VA_ARGS__)
 
 #define enable_warn_logging() logger.enable_logging(LOG_WARN, true);
 #define disable_warn_logging() logger.enable_logging(LOG_WARN, false);
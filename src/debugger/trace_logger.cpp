@@ -0,0 +1,78 @@
+#include "trace_logger.h"
+
+#include <chrono>
+#include <cstring>
+
+
+TraceLogger trace_logger;
+
+
+TraceLogger::TraceLogger():
+m_file(nullptr),
+m_running(false),
+m_enabled(false)
+{
+
+}
+
+TraceLogger::~TraceLogger() {
+    this->close();
+}
+
+void TraceLogger::open(const std::string &file_name) {
+    this->close();
+
+    m_file = std::fopen(file_name.c_str(), "wb");
+    if (m_file == nullptr) {
+        std::cerr << "Could not open trace file " << file_name << std::endl;
+        throw new std::exception;
+    }
+
+    TraceHeader_t header;
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_VERSION;
+    header.record_size = sizeof(TraceRecord_t);
+    std::fwrite(&header, sizeof(header), 1, m_file);
+
+    m_running = true;
+    m_writer = std::thread(&TraceLogger::write_records, this);
+    m_enabled = true;
+}
+
+// Stop the writer once everything queued so far is on disk
+void TraceLogger::close() {
+    m_enabled = false;
+
+    if (m_writer.joinable()) {
+        m_running = false;
+        m_writer.join();
+    }
+
+    if (m_file != nullptr) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+void TraceLogger::write_records() {
+    TraceRecord_t batch[TRACE_WRITE_BATCH];
+
+    while (true) {
+        // Read the flag first so records pushed before close are still drained
+        bool running = m_running.load();
+
+        size_t count = m_buffer.pop(batch, TRACE_WRITE_BATCH);
+        if (count > 0) {
+            std::fwrite(batch, sizeof(TraceRecord_t), count, m_file);
+            continue;
+        }
+
+        if (!running) {
+            break;
+        }
+
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+
+    std::fflush(m_file);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <iostream>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <atomic>
+#include <thread>
+
+#include "../utils/ring_buffer.h"
+
+
+const char TRACE_MAGIC[8] = {'G', 'B', 'T', 'R', 'A', 'C', 'E', '\0'};
+const uint32_t TRACE_VERSION = 1;
+// 64K records, about 1.5 MB, between the CPU and the writer thread
+const size_t TRACE_BUFFER_RECORDS = 1 << 16;
+const size_t TRACE_WRITE_BATCH = 1024;
+
+
+// Registers are captured before the instruction at pc executes
+typedef struct TraceRecord {
+    uint64_t cycle;
+    uint16_t pc;
+    uint16_t af;
+    uint16_t bc;
+    uint16_t de;
+    uint16_t hl;
+    uint16_t sp;
+    uint8_t opcode;
+    uint8_t operands[2];
+    uint8_t reserved;
+} TraceRecord_t;
+
+// Written once at the start of a trace file, records follow in host byte order
+typedef struct TraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+} TraceHeader_t;
+
+
+// Binary CPU trace, records are queued by the emulator thread and written
+// to disk by a background thread so tracing does not block on file IO
+class TraceLogger {
+    public:
+        TraceLogger();
+        virtual ~TraceLogger();
+
+        void open(const std::string &);
+        void close();
+
+        bool is_enabled() const;
+        void record(const TraceRecord_t &);
+
+    private:
+        void write_records();
+
+        RingBuffer<TraceRecord_t, TRACE_BUFFER_RECORDS> m_buffer;
+
+        std::FILE *m_file;
+        std::thread m_writer;
+        std::atomic<bool> m_running;
+        // Set and cleared by whichever thread opens or closes the trace
+        std::atomic<bool> m_enabled;
+};
+
+
+extern TraceLogger trace_logger;
+
+
+inline bool TraceLogger::is_enabled() const {
+    return m_enabled.load(std::memory_order_relaxed);
+}
+
+inline void TraceLogger::record(const TraceRecord_t &record) {
+    // Never drop records, wait for the writer if it falls behind
+    while (!m_buffer.push(record)) {
+        std::this_thread::yield();
+    }
+}
@@ -2,37 +2,36 @@
 
 
 Cartridge::Cartridge(std::vector<char> file_buffer, int num_rom_banks):
-m_cartridge_type(ROM_ONLY),
-m_cartridge_size(0),
-m_num_rom_banks(num_rom_banks)
+Cartridge(std::make_shared<ROMFile>(file_buffer, (size_t)num_rom_banks * ROM_BANK_SIZE), num_rom_banks)
 {
-    int buffer_index = 0;
-    for (int i = 0; i < m_num_rom_banks; i++) {
-        Memory *mem = new Memory(ROM_BANK_SIZE);
-        mem->init_memory();
-
-        int j = 0;
-        while (buffer_index < file_buffer.size() && j < ROM_BANK_SIZE) {
-            mem->write_memory(j, file_buffer[buffer_index]);
 
-            buffer_index++;
-            j++;
-        }
-
-        m_rom_banks.push_back(mem);
-    }
-    std::cout << "initialized " << m_rom_banks.size() << " ROM banks" << std::endl;
+}
 
-    if (m_rom_banks.size() != m_num_rom_banks) {
+Cartridge::Cartridge(std::shared_ptr<ROMFile> rom_file, int num_rom_banks):
+m_cartridge_type(ROM_ONLY),
+m_cartridge_size(0),
+m_num_rom_banks(num_rom_banks),
+m_rom_file(rom_file),
+m_rom(nullptr)
+{
+    if (m_rom_file == nullptr || m_num_rom_banks < 0) {
         std::cerr << "Cartridge initialization failed!" << std::endl;
         throw new std::exception;
     }
+
+    // A truncated image gets a zero padded private copy so every bank is readable
+    size_t banks_size = (size_t)m_num_rom_banks * ROM_BANK_SIZE;
+    if (m_rom_file->get_size() < banks_size) {
+        std::vector<char> file_buffer(m_rom_file->get_data(), m_rom_file->get_data() + m_rom_file->get_size());
+        m_rom_file = std::make_shared<ROMFile>(file_buffer, banks_size);
+    }
+
+    m_rom = m_rom_file->get_data();
+    std::cout << "initialized " << m_num_rom_banks << " ROM banks" << std::endl;
 }
 
 Cartridge::~Cartridge() {
-    for (int i = 0; i < m_rom_banks.size(); i++) {
-        delete m_rom_banks[i];
-    }
+
 }
 
 void Cartridge::set_cartridge_type(cartridge_type_t type) {
@@ -51,6 +50,27 @@ int Cartridge::get_num_rom_banks() const {
     return m_num_rom_banks;
 }
 
+int Cartridge::get_rom_bank_number() const {
+    return 1;
+}
+
+// Host pointer to the start of a ROM bank, nullptr if the bank does not exist
+const uint8_t *Cartridge::get_rom_bank(int bank) const {
+    if (bank < 0 || bank >= m_num_rom_banks || (size_t)(bank + 1) * ROM_BANK_SIZE > m_rom_file->get_size()) {
+        return nullptr;
+    }
+
+    return m_rom + (size_t)bank * ROM_BANK_SIZE;
+}
+
+void Cartridge::save_state(StateWriter &) const {
+
+}
+
+void Cartridge::load_state(StateReader &) {
+
+}
+
 
 ROMOnly::ROMOnly(std::vector<char> file_buffer, int num_rom_banks):
 Cartridge(file_buffer, num_rom_banks)
@@ -58,19 +78,23 @@ Cartridge(file_buffer, num_rom_banks)
     Cartridge::set_cartridge_type(ROM_ONLY);
 }
 
+ROMOnly::ROMOnly(std::shared_ptr<ROMFile> rom_file, int num_rom_banks):
+Cartridge(rom_file, num_rom_banks)
+{
+    Cartridge::set_cartridge_type(ROM_ONLY);
+}
+
 ROMOnly::~ROMOnly() {
 
 }
 
 uint8_t ROMOnly::read(uint16_t address) {
-    if (address > 2 * ROM_BANK_SIZE) {
+    if (address > 2 * ROM_BANK_SIZE || address >= m_rom_file->get_size()) {
         std::cerr << "ROMOnly read: Address out of range" << std::endl;
         throw new std::exception;
     }
 
-    unsigned int index = (unsigned int)address / ROM_BANK_SIZE;
-    address = address % ROM_BANK_SIZE;
-    return m_rom_banks[index]->read_memory(address);
+    return m_rom[address];
 }
 
 uint16_t ROMOnly::write(uint16_t address, uint8_t data) {
@@ -90,6 +114,16 @@ m_mode(ROM_MODE)
     Cartridge::set_cartridge_type(ROM_MBC1);
 }
 
+MBC1::MBC1(std::shared_ptr<ROMFile> rom_file, int num_rom_banks):
+Cartridge(rom_file, num_rom_banks),
+m_ram_enabled(false),
+m_rom_bank_bits(0x0),
+m_rom_bank_number(1),
+m_mode(ROM_MODE)
+{
+    Cartridge::set_cartridge_type(ROM_MBC1);
+}
+
 MBC1::~MBC1() {
     
 }
@@ -102,19 +136,20 @@ uint8_t MBC1::read(uint16_t address) {
 
     // Read from ROM bank 00
     if (address <= 0x3FFF) {
-        log_warn("MBC1 Read from Bank: 0, Address: %X", address);
-        return m_rom_banks[0]->read_memory(address);
+        log_memory("MBC1 Read from Bank: 0, Address: %X", address);
+        return m_rom[address];
     }
     // Read from ROM bank 01 -7F
     else if (address >= 0x4000 & address <= 0x7FFF) {
         address = address - 0x4000;
-        log_warn("MBC1 Read from Bank: %d, Address: %X", m_rom_bank_number, address);
-        if (m_rom_bank_number >= m_rom_banks.size()) {
+        log_memory("MBC1 Read from Bank: %d, Address: %X", m_rom_bank_number, address);
+        const uint8_t *bank = this->get_rom_bank(m_rom_bank_number);
+        if (bank == nullptr) {
             std::cerr << "Error: ROM Bank number greater than expected size" << std::endl;
             throw new std::exception;
         }
 
-        return m_rom_banks[m_rom_bank_number]->read_memory(address);
+        return bank[address];
     }
 
     return 0x0;
@@ -188,3 +223,22 @@ int MBC1::get_rom_bank_number() const {
 mode_select_t MBC1::get_mode() const {
     return m_mode;
 }
+
+void MBC1::save_state(StateWriter &writer) const {
+    writer.write(m_ram_enabled);
+    writer.write(m_rom_bank_bits);
+    writer.write<int32_t>(m_rom_bank_number);
+    writer.write<uint8_t>(m_mode);
+}
+
+void MBC1::load_state(StateReader &reader) {
+    reader.read(m_ram_enabled);
+    reader.read(m_rom_bank_bits);
+    m_rom_bank_number = reader.read<int32_t>();
+    m_mode = (mode_select_t)reader.read<uint8_t>();
+
+    if (m_rom_bank_number < 0 || m_rom_bank_number >= m_num_rom_banks) {
+        std::cerr << "Save state ROM bank " << m_rom_bank_number << " out of range" << std::endl;
+        throw new std::exception;
+    }
+}
@@ -2,10 +2,13 @@
 
 #include <iostream>
 #include <vector>
+#include <memory>
 #include <cstdint>
 
 #include "../memory/memory.h"
 #include "../debugger/logger.h"
+#include "../utils/state_buffer.h"
+#include "rom_file.h"
 
 
 const int ROM_BANK_SIZE = 16 * 1024;
@@ -50,6 +53,7 @@ typedef enum mode_select {
 class Cartridge {
     public:
         Cartridge(std::vector<char>, int);
+        Cartridge(std::shared_ptr<ROMFile>, int);
         virtual ~Cartridge();
 
         virtual uint8_t read(uint16_t) = 0;
@@ -60,18 +64,29 @@ class Cartridge {
         void set_num_rom_banks(int);
         int get_num_rom_banks() const;
 
+        // Bank currently mapped to 0x4000-0x7FFF
+        virtual int get_rom_bank_number() const;
+        const uint8_t *get_rom_bank(int) const;
+
+        // Bank controller registers, the ROM itself is not part of a save state
+        virtual void save_state(StateWriter &) const;
+        virtual void load_state(StateReader &);
+
     protected:
         cartridge_type_t m_cartridge_type;
         int m_cartridge_size;
         int m_num_rom_banks;
 
-        std::vector<Memory *> m_rom_banks;
+        // Banks are offsets into the ROM image, which may be shared with other cartridges
+        std::shared_ptr<ROMFile> m_rom_file;
+        const uint8_t *m_rom;
 };
 
 
 class ROMOnly : public Cartridge {
     public:
         ROMOnly(std::vector<char>, int);
+        ROMOnly(std::shared_ptr<ROMFile>, int);
         virtual ~ROMOnly();
 
         uint8_t read(uint16_t) override;
@@ -82,14 +97,18 @@ class ROMOnly : public Cartridge {
 class MBC1: public Cartridge {
     public:
         MBC1(std::vector<char>, int);
+        MBC1(std::shared_ptr<ROMFile>, int);
         virtual ~MBC1();
 
         uint8_t read(uint16_t) override;
         uint16_t write(uint16_t, uint8_t) override;
 
         bool is_ram_enabled() const;
-        int get_rom_bank_number() const;
+        int get_rom_bank_number() const override;
         mode_select_t get_mode() const;
+
+        void save_state(StateWriter &) const override;
+        void load_state(StateReader &) override;
     private:
         bool m_ram_enabled;
         uint8_t m_rom_bank_bits;
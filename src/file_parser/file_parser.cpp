@@ -1,7 +1,7 @@
 #include "file_parser.h"
 
 FileParser::FileParser():
-m_header_buffer_size(0)
+m_rom_file(nullptr)
 {
 
 }
@@ -11,30 +11,14 @@ FileParser::~FileParser() {
 }
 
 Cartridge *FileParser::load_rom(const std::string &file_name) {
-    std::ifstream file_buffer(file_name.c_str(), std::ios::binary | std::ios::ate);
-
-    if (!file_buffer.good()) {
-        std::cerr << "Exception opening/reading/closing file\n";
-        throw new std::exception;
-    }
-
-    std::ifstream::pos_type position = file_buffer.tellg();
-    size_t file_size = static_cast<size_t>(position);
-
-    std::vector<char> file_contents(file_size);
-
-    file_buffer.seekg(0, std::ios::beg);
-    file_buffer.read(&file_contents[0], position);
-    file_buffer.close();
-
-    m_header_buffer_size = file_size;
-    m_header_buffer = std::vector<uint8_t>(file_contents.begin(), file_contents.end());
+    m_rom_file = nullptr;
+    m_rom_file = std::make_shared<ROMFile>(file_name);
 
     switch (this->get_cartridge_type()) {
         case ROM_ONLY:
-            return new ROMOnly(file_contents, this->get_rom_size_banks());
+            return new ROMOnly(m_rom_file, this->get_rom_size_banks());
         case ROM_MBC1:
-            return new MBC1(file_contents, this->get_rom_size_banks());
+            return new MBC1(m_rom_file, this->get_rom_size_banks());
         default:
             std::cerr << "Cartridge type " << this->get_cartridge_type_string() << " not supported" << std::endl;
             throw new std::exception;
@@ -42,19 +26,27 @@ Cartridge *FileParser::load_rom(const std::string &file_name) {
 }
 
 std::vector<uint8_t> FileParser::get_buffer_data() {
-    return m_header_buffer;
+    if (m_rom_file == nullptr) {
+        return std::vector<uint8_t>();
+    }
+
+    return std::vector<uint8_t>(m_rom_file->get_data(), m_rom_file->get_data() + m_rom_file->get_size());
 }
 
 uint8_t FileParser::get_byte(int index) const {
-    if (index > m_header_buffer_size) {
+    if (index < 0 || index >= this->get_buffer_size()) {
         throw new std::exception;
     }
 
-    return m_header_buffer[index];
+    return m_rom_file->get_data()[index];
 }
 
 int FileParser::get_buffer_size() const {
-    return m_header_buffer_size;
+    if (m_rom_file == nullptr) {
+        return 0;
+    }
+
+    return m_rom_file->get_size();
 }
 
 std::string FileParser::get_rom_name() const {
@@ -4,8 +4,10 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <memory>
 
 #include "cartridge.h"
+#include "rom_file.h"
 
 
 class FileParser {
@@ -29,7 +31,6 @@ class FileParser {
         bool is_sgb() const;
     
     private:
-        std::vector<uint8_t> m_header_buffer;
-
-        size_t m_header_buffer_size;
+        // Mapped ROM image, shared with the cartridge created from it
+        std::shared_ptr<ROMFile> m_rom_file;
 };
\ No newline at end of file
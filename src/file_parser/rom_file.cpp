@@ -0,0 +1,128 @@
+#include "rom_file.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+ROMFile::ROMFile(const std::string &file_name):
+m_data(nullptr),
+m_size(0),
+m_mapped(false)
+{
+#ifdef _WIN32
+    m_file_handle = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    m_mapping_handle = NULL;
+    if (m_file_handle == INVALID_HANDLE_VALUE) {
+        std::cerr << "Exception opening/reading/closing file\n";
+        throw new std::exception;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(m_file_handle, &file_size) || file_size.QuadPart == 0) {
+        CloseHandle(m_file_handle);
+        std::cerr << "Exception opening/reading/closing file\n";
+        throw new std::exception;
+    }
+    m_size = static_cast<size_t>(file_size.QuadPart);
+
+    m_mapping_handle = CreateFileMappingA(m_file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (m_mapping_handle == NULL) {
+        CloseHandle(m_file_handle);
+        std::cerr << "Failed to map ROM file\n";
+        throw new std::exception;
+    }
+
+    m_data = static_cast<const uint8_t *>(MapViewOfFile(m_mapping_handle, FILE_MAP_READ, 0, 0, 0));
+    if (m_data == nullptr) {
+        CloseHandle(m_mapping_handle);
+        CloseHandle(m_file_handle);
+        std::cerr << "Failed to map ROM file\n";
+        throw new std::exception;
+    }
+    m_mapped = true;
+#else
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Exception opening/reading/closing file\n";
+        throw new std::exception;
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+        close(fd);
+        std::cerr << "Exception opening/reading/closing file\n";
+        throw new std::exception;
+    }
+    m_size = static_cast<size_t>(file_stat.st_size);
+
+    // Shared read-only mapping, the descriptor is not needed once mapped
+    void *data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data != MAP_FAILED) {
+        m_data = static_cast<const uint8_t *>(data);
+        m_mapped = true;
+    }
+    else {
+        // Fall back to reading the file for filesystems that cannot be mapped
+        m_buffer.resize(m_size);
+        size_t total = 0;
+        while (total < m_size) {
+            ssize_t count = ::read(fd, &m_buffer[total], m_size - total);
+            if (count <= 0) {
+                close(fd);
+                std::cerr << "Exception opening/reading/closing file\n";
+                throw new std::exception;
+            }
+            total += count;
+        }
+        m_data = m_buffer.data();
+    }
+
+    close(fd);
+#endif
+}
+
+ROMFile::ROMFile(const std::vector<char> &file_buffer, size_t min_size):
+m_data(nullptr),
+m_size(std::max(file_buffer.size(), min_size)),
+m_mapped(false),
+m_buffer(std::max(file_buffer.size(), min_size), 0)
+{
+#ifdef _WIN32
+    m_file_handle = INVALID_HANDLE_VALUE;
+    m_mapping_handle = NULL;
+#endif
+    std::copy(file_buffer.begin(), file_buffer.end(), m_buffer.begin());
+    m_data = m_buffer.data();
+}
+
+ROMFile::~ROMFile() {
+    if (!m_mapped) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+    CloseHandle(m_mapping_handle);
+    CloseHandle(m_file_handle);
+#else
+    munmap(const_cast<uint8_t *>(m_data), m_size);
+#endif
+}
+
+const uint8_t *ROMFile::get_data() const {
+    return m_data;
+}
+
+size_t ROMFile::get_size() const {
+    return m_size;
+}
+
+bool ROMFile::is_mapped() const {
+    return m_mapped;
+}
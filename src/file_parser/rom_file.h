@@ -0,0 +1,38 @@
+#pragma once
+
+#include <iostream>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+// Read-only view of a ROM image. Files are memory mapped so the OS pages
+// banks in on demand and every emulator instance shares the same pages.
+class ROMFile {
+    public:
+        ROMFile(const std::string &);
+        // Owned copy of an in-memory image, zero padded up to the given size
+        ROMFile(const std::vector<char> &, size_t);
+        virtual ~ROMFile();
+
+        ROMFile(const ROMFile &) = delete;
+        ROMFile &operator=(const ROMFile &) = delete;
+
+        const uint8_t *get_data() const;
+        size_t get_size() const;
+        bool is_mapped() const;
+
+    private:
+        const uint8_t *m_data;
+        size_t m_size;
+
+        bool m_mapped;
+        std::vector<uint8_t> m_buffer;
+
+#ifdef _WIN32
+        void *m_file_handle;
+        void *m_mapping_handle;
+#endif
+};
@@ -8,6 +8,11 @@ m_video(m_memory_map, m_ui, headless),
 m_timer(m_memory_map),
 m_debugger(m_cpu),
 m_framerate_observer(&m_video),
+m_pacer(FRAME_CLOCKS * GAMEBOY_FRAME_RATE),
+m_paced_frame(0),
+m_rewind(REWIND_MAX_SNAPSHOTS, REWIND_MAX_BYTES),
+m_rewind_enabled(!headless),
+m_movie_mode(MOVIE_OFF),
 m_debugger_enabled(debug),
 m_rom_name("")
 {
@@ -16,6 +21,12 @@ m_rom_name("")
         enable_warn_logging();
         enable_cpu_logging();
     }
+
+    m_video.set_scheduler(&m_scheduler);
+    m_timer.set_scheduler(&m_scheduler);
+
+    // Headless runs are for tests and screenshots, nobody is watching them in real time
+    m_pacer.set_speed(headless ? PACER_UNTHROTTLED : 1.0);
 }
 
 
@@ -38,14 +49,86 @@ void GameBoy::tick() {
         if (!m_debugger.step()) {
             return;
         }
+
+        // One instruction at a time while debugging
+        this->run_until(m_scheduler.get_cycles() + 1);
+        this->update_input();
+        return;
+    }
+
+    this->run_until(m_scheduler.get_next_event_time());
+    this->update_input();
+
+    // Frames with the LCD off are counted too, so they are paced the same
+    if (m_video.get_frame_count() != m_paced_frame) {
+        m_paced_frame = m_video.get_frame_count();
+        this->end_frame();
+    }
+}
+
+// Run the CPU freely up to the deadline or an earlier event it schedules, then let the
+// components whose events are due catch up
+void GameBoy::run_until(uint64_t deadline) {
+    do {
+        int cycle_count = m_cpu.tick();
+
+        // Nothing else runs while the CPU is stopped
+        if (m_cpu.is_stopped()) {
+            return;
+        }
+
+        m_scheduler.add_cycles(cycle_count);
+
+        // A write to TAC, TIMA, DIV or STAT can bring an event forward, stop at it instead
+        deadline = std::min(deadline, m_scheduler.get_next_event_time());
+
+        // HALT and polling loops wait for an event, jump straight to the earliest one
+        if (deadline != NO_EVENT && m_scheduler.get_cycles() < deadline) {
+            m_scheduler.add_cycles((int)m_cpu.fast_forward(deadline - m_scheduler.get_cycles()));
+        }
+    } while (m_scheduler.get_cycles() < deadline);
+
+    m_scheduler.run_due_events();
+}
+
+// Joypad changes are only applied between ticks, so a movie replays them at exactly
+// the same point of emulation as they were recorded
+void GameBoy::update_input() {
+    ButtonEvent_t event;
+
+    while (m_ui.take_button_event(event)) {
+        this->set_button_pressed(event.button, event.pressed);
+    }
+
+    if (m_movie_mode == MOVIE_REPLAYING) {
+        this->replay_input();
+    }
+}
+
+void GameBoy::replay_input() {
+    ButtonEvent_t event;
+
+    while (m_movie.next_event(m_scheduler.get_cycles(), event)) {
+        m_memory_map.set_button_pressed(event.button, event.pressed);
     }
+}
 
-    int cycle_count = m_cpu.tick();
+// Requests from the display, rewind snapshots, then wait for real time to catch up
+void GameBoy::end_frame() {
+    double speed;
+    if (m_ui.take_speed_request(speed)) {
+        this->set_speed(speed);
+    }
 
-    if (!m_cpu.is_stopped()) {
-        m_timer.tick(cycle_count);
-        m_video.tick(cycle_count);
+    if (m_ui.take_rewind_request()) {
+        this->rewind();
+    }
+    else if (m_rewind_enabled && m_paced_frame % REWIND_INTERVAL_FRAMES == 0) {
+        this->save_state(m_rewind_snapshot);
+        m_rewind.push(m_rewind_snapshot);
     }
+
+    m_pacer.wait(m_scheduler.get_cycles());
 }
 
 
@@ -76,15 +159,189 @@ bool GameBoy::is_display_open() const {
     return m_ui.is_display_enabled();
 }
 
+uint64_t GameBoy::get_frame_count() const {
+    return m_video.get_frame_count();
+}
+
+uint8_t GameBoy::peek(uint16_t address) {
+    return m_memory_map.peek(address);
+}
+
+void GameBoy::save_screenshot(const std::string &file_name) {
+    m_video.get_buffer().save_ppm(file_name);
+}
+
 void GameBoy::quit() {
     m_ui.set_display_enabled(false);
 }
 
-long int GameBoy::get_time_difference_ns() {
-    std::chrono::steady_clock::time_point end = get_time();
-    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - m_last_time).count();
+void GameBoy::set_speed(double speed) {
+    m_pacer.set_speed(speed);
+}
+
+double GameBoy::get_speed() const {
+    return m_pacer.get_speed();
+}
+
+const FramePacer &GameBoy::get_frame_pacer() const {
+    return m_pacer;
+}
+
+std::vector<uint8_t> GameBoy::save_state() {
+    std::vector<uint8_t> data;
+    data.reserve(ARENA_SIZE + LCD_WIDTH * LCD_HEIGHT + 256);
+    this->save_state(data);
+
+    return data;
+}
+
+// Replaces the contents, the capacity is reused
+void GameBoy::save_state(std::vector<uint8_t> &data) {
+    data.clear();
+
+    StateWriter writer(data);
+    writer.write(SAVE_STATE_MAGIC);
+    writer.write(SAVE_STATE_VERSION);
+    writer.write_string(m_rom_name);
+
+    m_scheduler.save_state(writer);
+    m_memory_map.save_state(writer);
+    m_cpu.save_state(writer);
+    m_video.save_state(writer);
+    m_timer.save_state(writer);
+}
+
+void GameBoy::load_state(const std::vector<uint8_t> &data) {
+    StateReader reader(data);
+
+    char magic[sizeof(SAVE_STATE_MAGIC)];
+    reader.read(magic);
+    if (std::memcmp(magic, SAVE_STATE_MAGIC, sizeof(magic)) != 0) {
+        std::cerr << "Not a save state" << std::endl;
+        throw new std::exception;
+    }
+
+    uint32_t version = reader.read<uint32_t>();
+    if (version != SAVE_STATE_VERSION) {
+        std::cerr << "Unsupported save state version: " << version << std::endl;
+        throw new std::exception;
+    }
+
+    std::string rom_name = reader.read_string();
+    if (rom_name != m_rom_name) {
+        std::cerr << "Save state is for " << rom_name << ", not " << m_rom_name << std::endl;
+        throw new std::exception;
+    }
+
+    // Deadlines are cleared first, video and timer schedule theirs again as they load
+    m_scheduler.load_state(reader);
+    m_memory_map.load_state(reader);
+    m_cpu.load_state(reader);
+    m_video.load_state(reader);
+    m_timer.load_state(reader);
+
+    if (!reader.at_end()) {
+        std::cerr << "Unexpected data at the end of the save state" << std::endl;
+        throw new std::exception;
+    }
+
+    m_paced_frame = m_video.get_frame_count();
+}
+
+void GameBoy::set_rewind_enabled(bool enabled) {
+    m_rewind_enabled = enabled;
+
+    if (!enabled) {
+        m_rewind.clear();
+    }
+}
+
+bool GameBoy::rewind() {
+    // Going back would leave a movie out of step with emulation
+    if (m_movie_mode != MOVIE_OFF) {
+        return false;
+    }
+
+    if (!m_rewind.pop(m_rewind_snapshot)) {
+        return false;
+    }
+
+    this->load_state(m_rewind_snapshot);
+    return true;
+}
+
+const RewindBuffer &GameBoy::get_rewind_buffer() const {
+    return m_rewind;
+}
+
+void GameBoy::set_button_pressed(Buttons_t button, bool pressed) {
+    // The movie drives the joypad while replaying
+    if (m_movie_mode == MOVIE_REPLAYING) {
+        return;
+    }
+
+    if (m_movie_mode == MOVIE_RECORDING) {
+        ButtonEvent_t event = {button, pressed};
+        m_movie.record(m_scheduler.get_cycles(), event);
+    }
+
+    m_memory_map.set_button_pressed(button, pressed);
+}
+
+void GameBoy::start_recording() {
+    m_movie.start_recording(m_rom_name, this->save_state());
+    m_movie_mode = MOVIE_RECORDING;
 }
 
-std::chrono::steady_clock::time_point GameBoy::get_time() {
-    return std::chrono::steady_clock::now();
-}
\ No newline at end of file
+void GameBoy::stop_recording(const std::string &file_name) {
+    if (m_movie_mode != MOVIE_RECORDING) {
+        return;
+    }
+
+    m_movie.stop_recording(m_scheduler.get_cycles());
+    m_movie_mode = MOVIE_OFF;
+
+    m_movie.save(file_name);
+}
+
+void GameBoy::start_replay(const std::string &file_name) {
+    m_movie.load(file_name);
+
+    // Checks the ROM, and starts from the same cycle the recording did
+    this->load_state(m_movie.get_start_state());
+
+    m_movie.start_replay();
+    m_movie_mode = MOVIE_REPLAYING;
+
+    // Input recorded before the first tick
+    this->replay_input();
+}
+
+bool GameBoy::is_replay_finished() const {
+    return m_movie_mode == MOVIE_REPLAYING && m_movie.is_replay_finished(m_scheduler.get_cycles());
+}
+
+MovieMode_t GameBoy::get_movie_mode() const {
+    return m_movie_mode;
+}
+
+void GameBoy::save_state_file(const std::string &file_name) {
+    std::vector<uint8_t> data = this->save_state();
+
+    std::ofstream file(file_name, std::ios::binary);
+    if (!file.write(reinterpret_cast<const char *>(data.data()), data.size())) {
+        std::cerr << "Could not write save state: " << file_name << std::endl;
+        throw new std::exception;
+    }
+}
+
+void GameBoy::load_state_file(const std::string &file_name) {
+    std::ifstream file(file_name, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Could not open save state: " << file_name << std::endl;
+        throw new std::exception;
+    }
+
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    this->load_state(data);
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <fstream>
 
 #include "cpu/cpu.h"
 #include "memory/memory_map.h"
@@ -9,7 +11,26 @@
 #include "video/video_observer.h"
 #include "user_interface/user_interface_sfml.h"
 #include "timer/timer.h"
+#include "scheduler/scheduler.h"
+#include "movie/movie.h"
 #include "debugger/debugger.h"
+#include "utils/frame_pacer.h"
+#include "utils/state_buffer.h"
+#include "utils/rewind_buffer.h"
+
+
+// 4194304 Hz / 70224 cycles per frame on the DMG
+const double GAMEBOY_FRAME_RATE = 4194304.0 / 70224.0;
+
+// Save states start with the magic, the format version and the ROM title, then the
+// scheduler, memory, CPU, video and timer sections. Bump the version when any section changes.
+const char SAVE_STATE_MAGIC[8] = {'G', 'B', 'S', 'T', 'A', 'T', 'E', '\0'};
+const uint32_t SAVE_STATE_VERSION = 1;
+
+// A rewind snapshot every 10 frames, up to 60 seconds or 8 MB of them
+const int REWIND_INTERVAL_FRAMES = 10;
+const size_t REWIND_MAX_SNAPSHOTS = 60 * 60 / REWIND_INTERVAL_FRAMES;
+const size_t REWIND_MAX_BYTES = 8 * 1024 * 1024;
 
 
 class GameBoy {
@@ -24,9 +45,44 @@ class GameBoy {
         std::string get_rom_name() const;
         bool is_display_open() const;
 
+        uint64_t get_frame_count() const;
+        // Memory as the CPU sees it, without IO side effects, for tests and tools
+        uint8_t peek(uint16_t);
+        void save_screenshot(const std::string &);
+
+        // 1.0 is real time, PACER_UNTHROTTLED runs as fast as possible
+        void set_speed(double);
+        double get_speed() const;
+        const FramePacer &get_frame_pacer() const;
+
+        // Complete machine state, only loadable with the same ROM loaded
+        std::vector<uint8_t> save_state();
+        void save_state(std::vector<uint8_t> &);
+        void load_state(const std::vector<uint8_t> &);
+        void save_state_file(const std::string &);
+        void load_state_file(const std::string &);
+
+        // Snapshots are taken while enabled, on by default unless headless
+        void set_rewind_enabled(bool);
+        // Go back to the newest snapshot, false if there is none
+        bool rewind();
+        const RewindBuffer &get_rewind_buffer() const;
+
+        // Joypad input from outside the display, recorded like the display's own
+        void set_button_pressed(Buttons_t, bool);
+
+        // Record joypad changes from now on, saved to the file when recording stops
+        void start_recording();
+        void stop_recording(const std::string &);
+        // Load the movie's start state and replay its input, the display's input is ignored
+        void start_replay(const std::string &);
+        bool is_replay_finished() const;
+        MovieMode_t get_movie_mode() const;
+
         void quit();
     
     private:
+        Scheduler m_scheduler;
         CPU m_cpu;
         MemoryMap m_memory_map;
         Video m_video;
@@ -36,13 +92,22 @@ class GameBoy {
         Debugger m_debugger;
         VideoObserver m_framerate_observer;
 
+        FramePacer m_pacer;
+        uint64_t m_paced_frame;
+
+        RewindBuffer m_rewind;
+        std::vector<uint8_t> m_rewind_snapshot;
+        bool m_rewind_enabled;
+
+        Movie m_movie;
+        MovieMode_t m_movie_mode;
+
         bool m_debugger_enabled;
 
         std::string m_rom_name;
 
-        std::chrono::steady_clock::time_point m_last_time;
-
-        // CPU Timing
-        long int get_time_difference_ns();
-        std::chrono::steady_clock::time_point get_time();
+        void run_until(uint64_t);
+        void end_frame();
+        void update_input();
+        void replay_input();
 };
\ No newline at end of file
@@ -1,9 +1,11 @@
+#include <chrono>
 #include <fstream>
 #include <iostream>
 
 #include <QApplication>
 
 #include "debugger/logger.h"
+#include "debugger/trace_logger.h"
 #include "utils/string_utils.h"
 #include "user_interface/launch_window.h"
 #include "gameboy.h"
@@ -13,6 +15,13 @@ int main(int argc, char** argv) {
     std::string rom_file = "";
     bool debugger_enabled = false;
     bool headless = false;
+    uint64_t max_frames = 0;
+    std::string screenshot_file = "";
+    double speed = -1;
+    std::string load_state_file = "";
+    std::string save_state_file = "";
+    std::string record_file = "";
+    std::string replay_file = "";
 
     if (argc > 1) {
         rom_file = argv[1];
@@ -30,11 +39,44 @@ int main(int argc, char** argv) {
                 headless = true;
             }
 
+            if (arg == "--frames" && i + 1 < argc) {
+                max_frames = std::stoull(argv[++i]);
+            }
+
+            if (arg == "--screenshot" && i + 1 < argc) {
+                screenshot_file = argv[++i];
+            }
+
+            if (arg == "--speed" && i + 1 < argc) {
+                speed = std::stod(argv[++i]);
+            }
+
+            if (arg == "--load-state" && i + 1 < argc) {
+                load_state_file = argv[++i];
+            }
+
+            if (arg == "--save-state" && i + 1 < argc) {
+                save_state_file = argv[++i];
+            }
+
+            if (arg == "--record" && i + 1 < argc) {
+                record_file = argv[++i];
+            }
+
+            if (arg == "--replay" && i + 1 < argc) {
+                replay_file = argv[++i];
+            }
+
             if (arg == "--warnings") {
                 enable_warn_logging();
             }
 
+            // Binary trace, decode with the trace decoder tool
             if (arg == "--trace") {
+                trace_logger.open("trace.gbt");
+            }
+
+            if (arg == "--trace-text") {
                 enable_cpu_logging();
             }
         }
@@ -43,9 +85,62 @@ int main(int argc, char** argv) {
     GameBoy gb(debugger_enabled, headless);
     gb.load_rom(rom_file);
 
+    if (!load_state_file.empty()) {
+        gb.load_state_file(load_state_file);
+    }
+
+    // A movie starts from the state it was recorded from
+    if (!replay_file.empty()) {
+        gb.start_replay(replay_file);
+    }
+    else if (!record_file.empty()) {
+        gb.start_recording();
+    }
+
+    if (speed >= 0) {
+        gb.set_speed(speed);
+    }
+
+    // Frames are counted from the loaded state
+    uint64_t start_frame = gb.get_frame_count();
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
     while (gb.is_display_open()) {
         gb.tick();
+
+        if (max_frames > 0 && gb.get_frame_count() - start_frame >= max_frames) {
+            break;
+        }
+
+        if (gb.is_replay_finished()) {
+            break;
+        }
+    }
+
+    if (!replay_file.empty()) {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+        uint64_t frames = gb.get_frame_count() - start_frame;
+        std::cout << "Replayed " << frames << " frames in " << seconds << " s, " << frames / seconds << " frames per second" << std::endl;
     }
 
+    if (!record_file.empty()) {
+        gb.stop_recording(record_file);
+    }
+
+    const FramePacer &pacer = gb.get_frame_pacer();
+    if (gb.get_speed() != PACER_UNTHROTTLED) {
+        std::cout << "Frame pacing drift: average " << pacer.get_average_drift_ns() / 1000 << " us, max " << pacer.get_max_drift_ns() / 1000 << " us, " << pacer.get_resync_count() << " resyncs" << std::endl;
+    }
+
+    if (!save_state_file.empty()) {
+        gb.save_state_file(save_state_file);
+    }
+
+    if (!screenshot_file.empty()) {
+        gb.save_screenshot(screenshot_file);
+    }
+
+    trace_logger.close();
+
     return 0;
 }
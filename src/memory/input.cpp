@@ -63,3 +63,10 @@ ButtonsPressed_t Input::get_input() {
     return m_buttons_pressed;
 }
 
+void Input::save_state(StateWriter &writer) const {
+    writer.write(m_buttons_pressed);
+}
+
+void Input::load_state(StateReader &reader) {
+    reader.read(m_buttons_pressed);
+}
@@ -4,6 +4,7 @@
 #include <cstdint>
 
 #include "../debugger/logger.h"
+#include "../utils/state_buffer.h"
 
 
 typedef enum Buttons {
@@ -18,6 +19,13 @@ typedef enum Buttons {
 } Buttons_t;
 
 
+// A button pressed or released, as delivered by the display or a movie
+typedef struct ButtonEvent {
+    Buttons_t button;
+    bool pressed;
+} ButtonEvent_t;
+
+
 typedef enum JoypadPorts {
     P10 = 0x01,
     P11 = 0x02,
@@ -50,6 +58,9 @@ class Input {
 
         ButtonsPressed_t get_input();
 
+        void save_state(StateWriter &) const;
+        void load_state(StateReader &);
+
     private:
         ButtonsPressed_t m_buttons_pressed;
 };
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "mem_io.h"
+
+
+// Lets a component react to accesses to the IO registers it owns instead of
+// polling them. Registered per register with MemoryMap::set_io_listener.
+class IOListener {
+    public:
+        // Called before a read, so a lazily computed register can be brought up to date
+        virtual void io_read(IORegisters_t) {}
+
+        virtual void io_written(IORegisters_t, uint8_t) = 0;
+};
@@ -368,4 +368,21 @@ void IO::increment_counter(IORegisters_t reg) {
             std::cerr << "IO register is not a counter. Cannot be incremented." << std::endl;
             throw new std::exception;
     }
-}
\ No newline at end of file
+}
+
+// Register values only, listeners are not notified when a state is loaded
+void IO::save_state(StateWriter &writer) const {
+    m_input.save_state(writer);
+
+    const uint8_t registers[] = {m_P1, m_DIV, m_TIMA, m_TMA, m_TAC, m_IF, m_LCDC, m_STAT, m_SCY, m_SCX, m_LY, m_LYC, m_DMA, m_BGP, m_OBP0, m_OBP1, m_WY, m_WX, m_IE};
+    writer.write(registers);
+}
+
+void IO::load_state(StateReader &reader) {
+    m_input.load_state(reader);
+
+    uint8_t *registers[] = {&m_P1, &m_DIV, &m_TIMA, &m_TMA, &m_TAC, &m_IF, &m_LCDC, &m_STAT, &m_SCY, &m_SCX, &m_LY, &m_LYC, &m_DMA, &m_BGP, &m_OBP0, &m_OBP1, &m_WY, &m_WX, &m_IE};
+    for (uint8_t *reg : registers) {
+        reader.read(*reg);
+    }
+}
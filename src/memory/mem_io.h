@@ -70,6 +70,9 @@ class IO {
         bool dpad_toggled() const;
         bool buttons_toggled() const;
 
+        void save_state(StateWriter &) const;
+        void load_state(StateReader &);
+
     private:
         Input m_input;
 
@@ -2,41 +2,39 @@
 
 
 Memory::Memory(int mem_size):
-m_memory_size(mem_size)
+m_memory(nullptr),
+m_memory_size(mem_size),
+m_owns_memory(true)
 {
 
 }
 
-Memory::~Memory() {
-    delete[] m_memory;
-}
-
-bool Memory::init_memory() {
-    m_memory = new uint8_t[m_memory_size];
+Memory::Memory(uint8_t *buffer, int mem_size):
+m_memory(buffer),
+m_memory_size(mem_size),
+m_owns_memory(false)
+{
 
-    return m_memory != nullptr;
 }
 
-uint16_t Memory::write_memory(uint16_t address, uint8_t data) {
-    if (address > m_memory_size) {
-        std::cerr << "Address out of range: address: " << address << " size: " << m_memory_size  << std::endl;
-        throw new std::exception;
+Memory::~Memory() {
+    if (m_owns_memory) {
+        delete[] m_memory;
     }
-    
-    m_memory[address] = data;
-
-    return address;
 }
 
-uint8_t Memory::read_memory(uint16_t address) {
-    if (address > m_memory_size) {
-        std::cerr << "Address out of range: address: " << address << " size: " << m_memory_size  << std::endl;
-        throw new std::exception;
+bool Memory::init_memory() {
+    if (m_owns_memory && m_memory == nullptr) {
+        m_memory = new uint8_t[m_memory_size];
     }
-    
-    return m_memory[address];
+
+    return m_memory != nullptr;
 }
 
 int Memory::get_size() const {
     return m_memory_size;
-}
\ No newline at end of file
+}
+
+uint8_t *Memory::get_buffer() const {
+    return m_memory;
+}
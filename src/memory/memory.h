@@ -8,6 +8,8 @@
 class Memory {
     public:
         Memory(int);
+        // View into memory owned elsewhere, such as the MemoryMap arena
+        Memory(uint8_t *, int);
         virtual ~Memory();
 
         bool init_memory();
@@ -16,8 +18,39 @@ class Memory {
         uint8_t read_memory(uint16_t);
 
         int get_size() const;
+        uint8_t *get_buffer() const;
 
     private:
         uint8_t *m_memory; 
         int m_memory_size;
-};
\ No newline at end of file
+        bool m_owns_memory;
+
+        void check_address(uint16_t) const;
+};
+
+
+// Bounds are only checked in builds with MEMORY_BOUNDS_CHECKS defined, normally Debug builds
+inline void Memory::check_address(uint16_t address) const {
+#ifdef MEMORY_BOUNDS_CHECKS
+    if (address >= m_memory_size) {
+        std::cerr << "Address out of range: address: " << address << " size: " << m_memory_size  << std::endl;
+        throw new std::exception;
+    }
+#else
+    (void)address;
+#endif
+}
+
+inline uint16_t Memory::write_memory(uint16_t address, uint8_t data) {
+    this->check_address(address);
+
+    m_memory[address] = data;
+
+    return address;
+}
+
+inline uint8_t Memory::read_memory(uint16_t address) {
+    this->check_address(address);
+
+    return m_memory[address];
+}
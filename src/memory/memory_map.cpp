@@ -1,7 +1,9 @@
 #include "memory_map.h"
 
 
-MemoryMap::MemoryMap() {
+MemoryMap::MemoryMap():
+m_cartridge(nullptr)
+{
     // 32 kB Cartridge ROM Bank #0
     m_address_space[0] = 0x0000;
     // 32 kB Cartridge Switchable ROM Bank
@@ -28,6 +30,27 @@ MemoryMap::MemoryMap() {
     m_address_space[11] = 0xFFFF;
 
     this->init_memory_map();
+
+    this->update_palette(BGP);
+    this->update_palette(OBP0);
+    this->update_palette(OBP1);
+}
+
+MemoryMap::MemoryMap(const MemoryMap &other):
+m_cartridge(other.m_cartridge),
+m_io(other.m_io)
+{
+    std::copy(other.m_address_space, other.m_address_space + 12, m_address_space);
+
+    this->init_memory_map();
+    this->map_rom_banks();
+
+    std::memcpy(m_arena, other.m_arena, ARENA_SIZE);
+    m_tile_cache.rebuild(m_vram->get_buffer());
+
+    this->update_palette(BGP);
+    this->update_palette(OBP0);
+    this->update_palette(OBP1);
 }
 
 MemoryMap::~MemoryMap() {
@@ -35,32 +58,109 @@ MemoryMap::~MemoryMap() {
     delete m_oam;
     delete m_internal_ram;
     delete m_high_ram;
+
+    delete[] m_arena_allocation;
 }
 
 void MemoryMap::init_memory_map() {
-    m_vram = new Memory(m_address_space[3] - m_address_space[2]);
-    m_oam = new Memory(m_address_space[7] - m_address_space[6]);
-    m_internal_ram = new Memory(m_address_space[5] - m_address_space[4]);
-    m_high_ram = new Memory(m_address_space[11] - m_address_space[10]);
-
-    m_vram->init_memory();
-    m_oam->init_memory();
-    m_internal_ram->init_memory();
-    m_high_ram->init_memory();
+    // Over-allocate so the arena can start on a cache line
+    m_arena_allocation = new uint8_t[ARENA_SIZE + CACHE_LINE_SIZE];
+    uintptr_t aligned = (reinterpret_cast<uintptr_t>(m_arena_allocation) + CACHE_LINE_SIZE - 1) & ~static_cast<uintptr_t>(CACHE_LINE_SIZE - 1);
+    m_arena = reinterpret_cast<uint8_t *>(aligned);
+    std::memset(m_arena, 0, ARENA_SIZE);
+
+    m_vram = new Memory(m_arena + ARENA_VRAM_OFFSET, m_address_space[3] - m_address_space[2]);
+    m_oam = new Memory(m_arena + ARENA_OAM_OFFSET, m_address_space[7] - m_address_space[6]);
+    m_internal_ram = new Memory(m_arena + ARENA_INTERNAL_RAM_OFFSET, m_address_space[5] - m_address_space[4]);
+    m_high_ram = new Memory(m_arena + ARENA_HIGH_RAM_OFFSET, m_address_space[11] - m_address_space[10]);
+
+    // Everything starts on the slow path, then plain RAM is mapped directly
+    this->map_pages(0x0000, 0x10000, nullptr, nullptr);
+
+    // VRAM writes stay on the slow path so write_vram sees them
+    this->map_pages(m_address_space[2], m_address_space[3], m_vram->get_buffer(), nullptr);
+    this->map_pages(m_address_space[4], m_address_space[5], m_internal_ram->get_buffer(), m_internal_ram->get_buffer());
+    // Echo RAM mirrors internal RAM up to OAM
+    this->map_pages(m_address_space[5], m_address_space[6], m_internal_ram->get_buffer(), m_internal_ram->get_buffer());
+
+    // Listeners are components attached to one MemoryMap, copies start without any
+    std::fill(m_io_listeners, m_io_listeners + NUM_IO_LISTENERS, nullptr);
+}
+
+// Point the pages covering [start, end) at consecutive 256 byte blocks of host memory
+void MemoryMap::map_pages(uint16_t start, int end, const uint8_t *read_memory, uint8_t *write_memory) {
+    for (int address = start; address < end; address += MEMORY_PAGE_SIZE) {
+        int page = address / MEMORY_PAGE_SIZE;
+        int offset = address - start;
+
+        m_read_pages[page] = (read_memory != nullptr) ? read_memory + offset : nullptr;
+        m_write_pages[page] = (write_memory != nullptr) ? write_memory + offset : nullptr;
+        m_page_offsets[page] = offset;
+    }
+}
+
+// Map ROM bank 0 and the currently selected bank, writes always go to the cartridge
+void MemoryMap::map_rom_banks() {
+    if (m_cartridge == nullptr) {
+        return;
+    }
+
+    this->map_pages(m_address_space[0], m_address_space[1], m_cartridge->get_rom_bank(0), nullptr);
+    this->map_pages(m_address_space[1], m_address_space[2], m_cartridge->get_rom_bank(m_cartridge->get_rom_bank_number()), nullptr);
+}
+
+uint8_t *MemoryMap::get_arena() const {
+    return m_arena;
+}
+
+const uint8_t *MemoryMap::get_oam() const {
+    return m_arena + ARENA_OAM_OFFSET;
+}
+
+const TileCache &MemoryMap::get_tile_cache() const {
+    return m_tile_cache;
+}
+
+const PaletteCache &MemoryMap::get_palette_cache() const {
+    return m_palette_cache;
+}
+
+void MemoryMap::update_palette(uint16_t address) {
+    switch (address) {
+        case BGP:
+            m_palette_cache.update_background(m_io.read(BGP));
+            break;
+        case OBP0:
+            m_palette_cache.update_sprite(OBJECT_PALETTE_0, m_io.read(OBP0));
+            break;
+        case OBP1:
+            m_palette_cache.update_sprite(OBJECT_PALETTE_1, m_io.read(OBP1));
+            break;
+    }
 }
 
 void MemoryMap::load_rom(Cartridge *cartridge) {
     m_cartridge = cartridge;
+
+    this->map_rom_banks();
 }
 
-uint16_t MemoryMap::write(uint16_t address, uint8_t data) {
+uint16_t MemoryMap::write_slow(uint16_t address, uint8_t data) {
+    // High RAM shares its page with IO, check it first since the stack usually lives here
+    if (address >= m_address_space[10] && address < m_address_space[11]) {
+        return m_high_ram->write_memory(address - m_address_space[10], data);
+    }
     // Cartridge ROM
-    if (address >= m_address_space[0] && address < m_address_space[2]) {
-        if (m_cartridge->get_cartridge_type() == ROM_ONLY) {
+    else if (address >= m_address_space[0] && address < m_address_space[2]) {
+        if (m_cartridge == nullptr || m_cartridge->get_cartridge_type() == ROM_ONLY) {
             log_warn("Cannot write to ROM");
         }
         else {
-            return m_cartridge->write(address, data);
+            // Writes to the MBC registers may switch banks
+            uint16_t result = m_cartridge->write(address, data);
+            this->map_rom_banks();
+
+            return result;
         }
     }
     // VRAM
@@ -69,7 +169,7 @@ uint16_t MemoryMap::write(uint16_t address, uint8_t data) {
     }
     // Switchable RAM
     else if (address >= m_address_space[3] && address < m_address_space[4]) {
-        if (m_cartridge->get_cartridge_type() == ROM_ONLY) {
+        if (m_cartridge == nullptr || m_cartridge->get_cartridge_type() == ROM_ONLY) {
             log_warn("Cannot write to interal RAM with a ROM_ONLY cartridge");
         }
     }
@@ -95,7 +195,17 @@ uint16_t MemoryMap::write(uint16_t address, uint8_t data) {
             this->dma_transfer(data);
         }
 
-        return this->m_io.write((IORegisters_t)address, data);
+        uint16_t result = this->m_io.write((IORegisters_t)address, data);
+        if (address == BGP || address == OBP0 || address == OBP1) {
+            this->update_palette(address);
+        }
+
+        IOListener *listener = m_io_listeners[address & 0xFF];
+        if (listener != nullptr) {
+            listener->io_written((IORegisters_t)address, data);
+        }
+
+        return result;
     }
     // Unused space
     else if (address >= m_address_space[9] && address < m_address_space[10]) {
@@ -117,9 +227,18 @@ uint16_t MemoryMap::write(uint16_t address, uint8_t data) {
     return 0x0;
 }
 
-uint8_t MemoryMap::read(uint16_t address) {
+uint8_t MemoryMap::read_slow(uint16_t address) {
+    // High RAM shares its page with IO, check it first since the stack usually lives here
+    if (address >= m_address_space[10] && address < m_address_space[11]) {
+        return m_high_ram->read_memory(address - m_address_space[10]);
+    }
     // Cartridge ROM
-    if (address >= m_address_space[0] && address < m_address_space[2]) {
+    else if (address >= m_address_space[0] && address < m_address_space[2]) {
+        if (m_cartridge == nullptr) {
+            log_warn("No cartridge loaded");
+            return 0x0;
+        }
+
         return m_cartridge->read(address);
     }
     // VRAM
@@ -128,7 +247,7 @@ uint8_t MemoryMap::read(uint16_t address) {
     }
     // Switchable RAM
     else if (address >= m_address_space[3] && address < m_address_space[4]) {
-        if (m_cartridge->get_cartridge_type() == ROM_ONLY) {
+        if (m_cartridge == nullptr || m_cartridge->get_cartridge_type() == ROM_ONLY) {
             log_warn("Cannot read from internal RAM with a ROM_ONLY cartridge");
         }
     }
@@ -150,6 +269,11 @@ uint8_t MemoryMap::read(uint16_t address) {
     }
     // IO
     else if (address >= m_address_space[8] && address < m_address_space[9]) {
+        IOListener *listener = m_io_listeners[address & 0xFF];
+        if (listener != nullptr) {
+            listener->io_read((IORegisters_t)address);
+        }
+
         return this->m_io.read((IORegisters_t)address);
     }
     // Unused space
@@ -184,7 +308,10 @@ uint16_t MemoryMap::write_vram(uint16_t address, uint8_t data) {
         log_memory("MemoryMap: Writing %X to Background Map 1 at address %X", data, address);
     }
 
-    return m_vram->write_memory(address - m_address_space[2], data);
+    uint16_t offset = m_vram->write_memory(address - m_address_space[2], data);
+    m_tile_cache.update(offset, m_vram->get_buffer());
+
+    return offset;
 }
 
 uint8_t MemoryMap::read_vram(uint16_t address) {
@@ -204,18 +331,15 @@ uint8_t MemoryMap::read_vram(uint16_t address) {
 }
 
 uint16_t MemoryMap::write_oam(uint16_t address, uint8_t data) {
-    int sprite_index = (address - m_address_space[6]) / 40;
-    log_memory("MemoryMap: Writing %X to OAM at address %X. Sprite index: %d", data, address, sprite_index);
+    log_memory("MemoryMap: Writing %X to OAM at address %X. Sprite index: %d", data, address, (address - m_address_space[6]) / 40);
 
     return m_oam->write_memory(address - m_address_space[6], data);
 }
 
 uint8_t MemoryMap::read_oam(uint16_t address) {
-    int sprite_index = (address - m_address_space[6]) / 40;
-
     uint8_t data = m_oam->read_memory(address - m_address_space[6]);
 
-    log_memory("MemoryMap: Reading %X from OAM at address %X. Sprite index: %d", data, address, sprite_index);
+    log_memory("MemoryMap: Reading %X from OAM at address %X. Sprite index: %d", data, address, (address - m_address_space[6]) / 40);
 
     return data;
 }
@@ -276,3 +400,43 @@ void MemoryMap::set_button_pressed(Buttons_t button, bool pressed) {
 void MemoryMap::increment_io_counter(IORegisters_t reg) {
     m_io.increment_counter(reg);
 }
+
+void MemoryMap::set_io_register(IORegisters_t reg, uint8_t data) {
+    m_io.write(reg, data);
+}
+
+void MemoryMap::set_io_listener(IORegisters_t reg, IOListener *listener) {
+    m_io_listeners[reg & 0xFF] = listener;
+}
+
+void MemoryMap::save_state(StateWriter &writer) const {
+    writer.write_bytes(m_arena, ARENA_SIZE);
+    m_io.save_state(writer);
+
+    writer.write<bool>(m_cartridge != nullptr);
+    if (m_cartridge != nullptr) {
+        m_cartridge->save_state(writer);
+    }
+}
+
+void MemoryMap::load_state(StateReader &reader) {
+    reader.read_bytes(m_arena, ARENA_SIZE);
+    m_io.load_state(reader);
+
+    bool has_cartridge = reader.read<bool>();
+    if (has_cartridge != (m_cartridge != nullptr)) {
+        std::cerr << "Save state cartridge does not match the loaded ROM" << std::endl;
+        throw new std::exception;
+    }
+
+    if (m_cartridge != nullptr) {
+        m_cartridge->load_state(reader);
+    }
+
+    // Everything derived from the restored memory
+    this->map_rom_banks();
+    m_tile_cache.rebuild(m_vram->get_buffer());
+    this->update_palette(BGP);
+    this->update_palette(OBP0);
+    this->update_palette(OBP1);
+}
@@ -1,12 +1,18 @@
 #pragma once
 
 #include <exception>
+#include <algorithm>
+#include <cstring>
 
 #include "memory.h"
 #include "mem_io.h"
+#include "io_listener.h"
 #include "../file_parser/cartridge.h"
 #include "../video/definitions.h"
+#include "../video/tile_cache.h"
+#include "../video/palette_cache.h"
 #include "../debugger/logger.h"
+#include "../utils/state_buffer.h"
 
 
 typedef enum InterruptFlag {
@@ -18,15 +24,36 @@ typedef enum InterruptFlag {
 } InterruptFlag_t;
 
 
+// The 64 kB address space is split into 256 byte pages for the read/write fast path
+const int MEMORY_PAGE_SIZE = 0x100;
+const int NUM_MEMORY_PAGES = 0x100;
+
+// One listener slot per address in the IO page, 0xFF00-0xFFFF
+const int NUM_IO_LISTENERS = 0x100;
+
+// VRAM, internal RAM, OAM and high RAM share one arena, each region starts on a cache line
+const int CACHE_LINE_SIZE = 64;
+const int ARENA_VRAM_OFFSET = 0x0000;
+const int ARENA_INTERNAL_RAM_OFFSET = 0x2000;
+const int ARENA_OAM_OFFSET = 0x4000;
+const int ARENA_HIGH_RAM_OFFSET = 0x40C0;
+const int ARENA_SIZE = 0x4140;
+
+
 class MemoryMap {
     public:
         MemoryMap();
+        MemoryMap(const MemoryMap &);
         virtual ~MemoryMap();
 
+        MemoryMap &operator=(const MemoryMap &) = delete;
+
         void init_memory_map();
         void load_rom(Cartridge*);
         uint16_t write(uint16_t, uint8_t);
         uint8_t read(uint16_t);
+        // Same value as read, but IO listeners are not notified, for tracing and debugging
+        uint8_t peek(uint16_t);
 
         uint16_t write_vram(uint16_t, uint8_t);
         uint8_t read_vram(uint16_t);
@@ -34,6 +61,7 @@ class MemoryMap {
         uint8_t read_oam(uint16_t);
 
         void dma_transfer(uint8_t);
+        void update_palette(uint16_t);
 
         bool get_interrupt_enable_bit(InterruptFlag_t);
         bool get_interrupt_flag_bit(InterruptFlag_t);
@@ -44,15 +72,89 @@ class MemoryMap {
 
         void increment_io_counter(IORegisters_t);
 
+        // Store a value computed by the component that owns the register, listeners are not notified
+        void set_io_register(IORegisters_t, uint8_t);
+
+        // Notify listener before every read and after every write of the register, nullptr removes it
+        void set_io_listener(IORegisters_t, IOListener *);
+
+        // Snapshot or restore all internal memory with a single copy of ARENA_SIZE bytes
+        uint8_t *get_arena() const;
+
+        // RAM, IO registers and cartridge bank registers. The cartridge loaded must be
+        // the one the state was saved with.
+        void save_state(StateWriter &) const;
+        void load_state(StateReader &);
+
+        // OAM as stored in the arena, 40 entries of 4 bytes
+        const uint8_t *get_oam() const;
+
+        // Decoded copy of the VRAM tile data, kept in sync by write_vram
+        const TileCache &get_tile_cache() const;
+        // Decoded BGP/OBP0/OBP1, kept in sync by writes to the IO registers
+        const PaletteCache &get_palette_cache() const;
+
     private:
         int m_address_space[12];
 
+        // Host pointers for plain RAM/ROM pages, nullptr sends an access to the slow path
+        const uint8_t *m_read_pages[NUM_MEMORY_PAGES];
+        uint8_t *m_write_pages[NUM_MEMORY_PAGES];
+        // Offset of each page within its region, returned by write
+        uint16_t m_page_offsets[NUM_MEMORY_PAGES];
+
+        IOListener *m_io_listeners[NUM_IO_LISTENERS];
+
+        uint16_t write_slow(uint16_t, uint8_t);
+        uint8_t read_slow(uint16_t);
+
+        void map_pages(uint16_t, int, const uint8_t *, uint8_t *);
+        void map_rom_banks();
+
+        uint8_t *m_arena_allocation;
+        uint8_t *m_arena;
+
         Memory *m_vram;
         Memory *m_oam;
         Memory *m_internal_ram;
         Memory *m_high_ram;
 
+        TileCache m_tile_cache;
+        PaletteCache m_palette_cache;
+
         Cartridge *m_cartridge;
 
         IO m_io;
 };
+
+
+inline uint16_t MemoryMap::write(uint16_t address, uint8_t data) {
+    uint8_t page = address >> 8;
+    uint8_t *memory = m_write_pages[page];
+
+    if (memory == nullptr) {
+        return this->write_slow(address, data);
+    }
+
+    memory[address & 0xFF] = data;
+
+    return m_page_offsets[page] + (address & 0xFF);
+}
+
+inline uint8_t MemoryMap::read(uint16_t address) {
+    const uint8_t *memory = m_read_pages[address >> 8];
+
+    if (memory == nullptr) {
+        return this->read_slow(address);
+    }
+
+    return memory[address & 0xFF];
+}
+
+inline uint8_t MemoryMap::peek(uint16_t address) {
+    if (address >= m_address_space[8] && address < m_address_space[9]) {
+        return m_io.read((IORegisters_t)address);
+    }
+
+    return this->read(address);
+}
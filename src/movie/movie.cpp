@@ -0,0 +1,135 @@
+#include "movie.h"
+
+
+Movie::Movie():
+m_rom_name(""),
+m_end_cycle(0),
+m_next_event(0)
+{
+
+}
+
+Movie::~Movie() {
+
+}
+
+void Movie::start_recording(const std::string &rom_name, const std::vector<uint8_t> &start_state) {
+    m_rom_name = rom_name;
+    m_start_state = start_state;
+    m_end_cycle = 0;
+    m_events.clear();
+    m_next_event = 0;
+}
+
+void Movie::record(uint64_t cycle, const ButtonEvent_t &input) {
+    MovieEvent_t event = {cycle, input};
+    m_events.push_back(event);
+}
+
+void Movie::stop_recording(uint64_t cycle) {
+    m_end_cycle = cycle;
+}
+
+void Movie::start_replay() {
+    m_next_event = 0;
+}
+
+bool Movie::next_event(uint64_t cycle, ButtonEvent_t &input) {
+    if (m_next_event >= m_events.size() || m_events[m_next_event].cycle > cycle) {
+        return false;
+    }
+
+    input = m_events[m_next_event++].input;
+    return true;
+}
+
+bool Movie::is_replay_finished(uint64_t cycle) const {
+    return m_next_event >= m_events.size() && cycle >= m_end_cycle;
+}
+
+const std::string &Movie::get_rom_name() const {
+    return m_rom_name;
+}
+
+const std::vector<uint8_t> &Movie::get_start_state() const {
+    return m_start_state;
+}
+
+uint64_t Movie::get_end_cycle() const {
+    return m_end_cycle;
+}
+
+size_t Movie::get_num_events() const {
+    return m_events.size();
+}
+
+void Movie::save(const std::string &file_name) const {
+    std::vector<uint8_t> data;
+    StateWriter writer(data);
+
+    writer.write(MOVIE_MAGIC);
+    writer.write(MOVIE_VERSION);
+    writer.write_string(m_rom_name);
+    writer.write_vector(m_start_state);
+    writer.write(m_end_cycle);
+
+    writer.write<uint32_t>(m_events.size());
+    for (const MovieEvent_t &event : m_events) {
+        writer.write(event.cycle);
+        writer.write<uint8_t>(event.input.button);
+        writer.write<uint8_t>(event.input.pressed);
+    }
+
+    std::ofstream file(file_name, std::ios::binary);
+    if (!file.write(reinterpret_cast<const char *>(data.data()), data.size())) {
+        std::cerr << "Could not write movie: " << file_name << std::endl;
+        throw new std::exception;
+    }
+}
+
+void Movie::load(const std::string &file_name) {
+    std::ifstream file(file_name, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Could not open movie: " << file_name << std::endl;
+        throw new std::exception;
+    }
+
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    StateReader reader(data);
+
+    char magic[sizeof(MOVIE_MAGIC)];
+    reader.read(magic);
+    if (std::memcmp(magic, MOVIE_MAGIC, sizeof(magic)) != 0) {
+        std::cerr << "Not a movie: " << file_name << std::endl;
+        throw new std::exception;
+    }
+
+    uint32_t version = reader.read<uint32_t>();
+    if (version != MOVIE_VERSION) {
+        std::cerr << "Unsupported movie version: " << version << std::endl;
+        throw new std::exception;
+    }
+
+    m_rom_name = reader.read_string();
+    m_start_state = reader.read_vector();
+    reader.read(m_end_cycle);
+
+    uint32_t num_events = reader.read<uint32_t>();
+    m_events.clear();
+    m_events.reserve(std::min<size_t>(num_events, data.size() / MOVIE_EVENT_BYTES));
+    for (uint32_t i = 0; i < num_events; i++) {
+        MovieEvent_t event;
+        reader.read(event.cycle);
+        event.input.button = (Buttons_t)reader.read<uint8_t>();
+        event.input.pressed = reader.read<uint8_t>() != 0;
+
+        if (event.input.button > START || (i > 0 && event.cycle < m_events.back().cycle)) {
+            std::cerr << "Invalid movie event " << i << std::endl;
+            throw new std::exception;
+        }
+
+        m_events.push_back(event);
+    }
+
+    m_next_event = 0;
+}
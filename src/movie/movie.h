@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "../memory/input.h"
+#include "../utils/state_buffer.h"
+
+
+const char MOVIE_MAGIC[8] = {'G', 'B', 'M', 'O', 'V', 'I', 'E', '\0'};
+const uint32_t MOVIE_VERSION = 1;
+// Cycle, button and pressed as stored in the file
+const size_t MOVIE_EVENT_BYTES = 10;
+
+
+typedef enum MovieMode {
+    MOVIE_OFF,
+    MOVIE_RECORDING,
+    MOVIE_REPLAYING
+} MovieMode_t;
+
+
+// Joypad change applied at the start of the first tick at or after cycle
+typedef struct MovieEvent {
+    uint64_t cycle;
+    ButtonEvent_t input;
+} MovieEvent_t;
+
+
+// Button changes keyed by master cycle, recorded from a save state taken when recording
+// started. Replaying from that state applies each change at the same tick, so the run is
+// identical no matter how fast it goes.
+//
+// File: magic, version, ROM title, start state, end cycle, then the events,
+// in host byte order like save states.
+class Movie {
+    public:
+        Movie();
+        virtual ~Movie();
+
+        void start_recording(const std::string &, const std::vector<uint8_t> &);
+        void record(uint64_t, const ButtonEvent_t &);
+        void stop_recording(uint64_t);
+
+        void start_replay();
+        // Next event due at cycle, false once none are due yet
+        bool next_event(uint64_t, ButtonEvent_t &);
+        bool is_replay_finished(uint64_t) const;
+
+        const std::string &get_rom_name() const;
+        const std::vector<uint8_t> &get_start_state() const;
+        uint64_t get_end_cycle() const;
+        size_t get_num_events() const;
+
+        void save(const std::string &) const;
+        void load(const std::string &);
+
+    private:
+        std::string m_rom_name;
+        std::vector<uint8_t> m_start_state;
+        uint64_t m_end_cycle;
+
+        std::vector<MovieEvent_t> m_events;
+        size_t m_next_event;
+};
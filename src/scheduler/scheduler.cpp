@@ -0,0 +1,103 @@
+#include "scheduler.h"
+
+
+Scheduler::Scheduler():
+m_cycles(0)
+{
+    std::fill(m_deadlines, m_deadlines + NUM_EVENT_TYPES, NO_EVENT);
+    std::fill(m_handlers, m_handlers + NUM_EVENT_TYPES, nullptr);
+}
+
+Scheduler::~Scheduler() {
+
+}
+
+void Scheduler::set_handler(EventType_t type, EventHandler *handler) {
+    m_handlers[type] = handler;
+}
+
+void Scheduler::schedule(EventType_t type, uint64_t timestamp) {
+    if (m_deadlines[type] == timestamp) {
+        return;
+    }
+
+    m_deadlines[type] = timestamp;
+
+    if (m_events.size() >= MAX_SCHEDULED_EVENTS) {
+        this->rebuild_events();
+        return;
+    }
+
+    Event_t event = {timestamp, type};
+    m_events.push_back(event);
+    std::push_heap(m_events.begin(), m_events.end(), later_event);
+
+    this->drop_stale_events();
+}
+
+void Scheduler::cancel(EventType_t type) {
+    m_deadlines[type] = NO_EVENT;
+
+    this->drop_stale_events();
+}
+
+uint64_t Scheduler::get_deadline(EventType_t type) const {
+    return m_deadlines[type];
+}
+
+void Scheduler::run_due_events() {
+    while (!m_events.empty() && m_events.front().timestamp <= m_cycles) {
+        EventType_t type = m_events.front().type;
+        this->pop_event();
+
+        // The handler usually schedules its next deadline
+        m_deadlines[type] = NO_EVENT;
+        if (m_handlers[type] != nullptr) {
+            m_handlers[type]->handle_event(type, m_cycles);
+        }
+
+        this->drop_stale_events();
+    }
+}
+
+void Scheduler::save_state(StateWriter &writer) const {
+    writer.write(m_cycles);
+}
+
+void Scheduler::load_state(StateReader &reader) {
+    reader.read(m_cycles);
+
+    m_events.clear();
+    std::fill(m_deadlines, m_deadlines + NUM_EVENT_TYPES, NO_EVENT);
+}
+
+// std heaps are max-heaps, order by the later timestamp to keep the earliest event at the front
+bool Scheduler::later_event(const Event_t &a, const Event_t &b) {
+    return a.timestamp > b.timestamp;
+}
+
+void Scheduler::pop_event() {
+    std::pop_heap(m_events.begin(), m_events.end(), later_event);
+    m_events.pop_back();
+}
+
+// Keep a live event at the front so get_next_event_time is a single load
+void Scheduler::drop_stale_events() {
+    while (!m_events.empty() && m_events.front().timestamp != m_deadlines[m_events.front().type]) {
+        this->pop_event();
+    }
+}
+
+// Start the heap again from the live deadlines only
+void Scheduler::rebuild_events() {
+    m_events.clear();
+
+    for (int type = 0; type < NUM_EVENT_TYPES; type++) {
+        if (m_deadlines[type] != NO_EVENT) {
+            Event_t event = {m_deadlines[type], (EventType_t)type};
+            m_events.push_back(event);
+        }
+    }
+
+    std::make_heap(m_events.begin(), m_events.end(), later_event);
+}
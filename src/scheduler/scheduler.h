@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <limits>
+
+#include "../utils/state_buffer.h"
+
+
+// Components that run on deadlines instead of being ticked every instruction
+typedef enum EventType {
+    EVENT_VIDEO,
+    EVENT_TIMER,
+    NUM_EVENT_TYPES
+} EventType_t;
+
+
+const uint64_t NO_EVENT = std::numeric_limits<uint64_t>::max();
+
+// Replaced deadlines are rebuilt out of the heap once it grows past this
+const size_t MAX_SCHEDULED_EVENTS = 64;
+
+
+class EventHandler {
+    public:
+        // Called once the master cycle count reaches the scheduled timestamp, with the current count
+        virtual void handle_event(EventType_t, uint64_t) = 0;
+};
+
+
+// Master cycle counter and a min-heap of component deadlines. Each event type
+// has at most one pending deadline, scheduling it again replaces the old one.
+class Scheduler {
+    public:
+        Scheduler();
+        virtual ~Scheduler();
+
+        uint64_t get_cycles() const;
+        void add_cycles(int);
+
+        void set_handler(EventType_t, EventHandler *);
+
+        void schedule(EventType_t, uint64_t);
+        void cancel(EventType_t);
+        uint64_t get_deadline(EventType_t) const;
+
+        uint64_t get_next_event_time() const;
+        void run_due_events();
+
+        // Only the cycle count is saved, loading drops every deadline and each
+        // component schedules its own again from its loaded state
+        void save_state(StateWriter &) const;
+        void load_state(StateReader &);
+
+    private:
+        typedef struct Event {
+            uint64_t timestamp;
+            EventType_t type;
+        } Event_t;
+
+        uint64_t m_cycles;
+
+        // Replaced deadlines stay in the heap and are skipped when they no longer match m_deadlines
+        std::vector<Event_t> m_events;
+        uint64_t m_deadlines[NUM_EVENT_TYPES];
+        EventHandler *m_handlers[NUM_EVENT_TYPES];
+
+        static bool later_event(const Event_t &, const Event_t &);
+
+        void pop_event();
+        void drop_stale_events();
+        void rebuild_events();
+};
+
+
+inline uint64_t Scheduler::get_cycles() const {
+    return m_cycles;
+}
+
+inline void Scheduler::add_cycles(int cycles) {
+    m_cycles += cycles;
+}
+
+inline uint64_t Scheduler::get_next_event_time() const {
+    return m_events.empty() ? NO_EVENT : m_events.front().timestamp;
+}
@@ -1,25 +1,224 @@
 #include "timer.h"
 
 
-#define DIV_CYCLES  256
-
-
 Timer::Timer(MemoryMap &memory_map):
 m_memory_map(memory_map),
-m_cycle_counter(0)
+m_scheduler(nullptr),
+m_cycles(0),
+m_div_start(0),
+m_tima(0),
+m_tma(0),
+m_tac(0),
+m_tima_synced(0),
+m_overflow_time(NO_EVENT)
 {
-
+    m_memory_map.set_io_listener(DIV, this);
+    m_memory_map.set_io_listener(TIMA, this);
+    m_memory_map.set_io_listener(TMA, this);
+    m_memory_map.set_io_listener(TAC, this);
 }
 
 Timer::~Timer() {
-
+    m_memory_map.set_io_listener(DIV, nullptr);
+    m_memory_map.set_io_listener(TIMA, nullptr);
+    m_memory_map.set_io_listener(TMA, nullptr);
+    m_memory_map.set_io_listener(TAC, nullptr);
 }
 
 void Timer::tick(int cycles) {
-    m_cycle_counter += cycles;
+    m_cycles += cycles;
+
+    this->sync(m_cycles);
+}
+
+void Timer::set_scheduler(Scheduler *scheduler) {
+    this->sync(this->get_cycles());
+
+    // Keep the counter and TIMA where they were when switching time sources
+    uint64_t cycles = scheduler->get_cycles();
+    m_div_start = cycles - (m_cycles - m_div_start);
+    m_tima_synced = cycles;
+
+    m_scheduler = scheduler;
+    m_scheduler->set_handler(EVENT_TIMER, this);
+    this->schedule_next_event();
+}
+
+void Timer::handle_event(EventType_t, uint64_t cycles) {
+    this->sync(cycles);
+    this->schedule_next_event();
+}
+
+// TIMA is brought up to date first, so the state never has increments left to count
+void Timer::save_state(StateWriter &writer) {
+    this->sync(this->get_cycles());
+
+    writer.write(m_cycles);
+    writer.write(m_div_start);
+    writer.write(m_tima);
+    writer.write(m_tma);
+    writer.write(m_tac);
+    writer.write(m_tima_synced);
+    writer.write(m_overflow_time);
+}
+
+void Timer::load_state(StateReader &reader) {
+    reader.read(m_cycles);
+    reader.read(m_div_start);
+    reader.read(m_tima);
+    reader.read(m_tma);
+    reader.read(m_tac);
+    reader.read(m_tima_synced);
+    reader.read(m_overflow_time);
+
+    this->schedule_next_event();
+}
+
+void Timer::io_read(IORegisters_t reg) {
+    switch (reg) {
+        case DIV:
+            m_memory_map.set_io_register(DIV, this->get_div_counter() >> 8);
+            break;
+        case TIMA:
+            this->sync(this->get_cycles());
+            m_memory_map.set_io_register(TIMA, m_tima);
+            break;
+        default:
+            break;
+    }
+}
+
+void Timer::io_written(IORegisters_t reg, uint8_t data) {
+    uint64_t cycles = this->get_cycles();
+    this->sync(cycles);
+
+    int period = this->get_timer_period();
+    bool timer_signal = this->timer_enabled() && (this->get_div_counter() & (period / 2));
+
+    switch (reg) {
+        case DIV:
+            // Any write resets the counter, if the selected bit was set TIMA sees a falling edge
+            if (timer_signal) {
+                this->increment_tima(cycles);
+            }
+            m_div_start = cycles;
+            m_memory_map.set_io_register(DIV, 0x0);
+            break;
+        case TIMA:
+            // Writing during the reload delay cancels the reload and the interrupt
+            m_overflow_time = NO_EVENT;
+            m_tima = data;
+            break;
+        case TMA:
+            m_tma = data;
+            break;
+        case TAC:
+            m_tac = data & 0x07;
+
+            // Disabling the timer or selecting a cleared bit is also a falling edge
+            if (timer_signal && !(this->timer_enabled() && (this->get_div_counter() & (this->get_timer_period() / 2)))) {
+                this->increment_tima(cycles);
+            }
+            break;
+        default:
+            break;
+    }
+
+    this->schedule_next_event();
+}
 
-    if (m_cycle_counter > DIV_CYCLES) {
-        m_memory_map.increment_io_counter(DIV);
-        m_cycle_counter = 0;
+uint16_t Timer::get_div_counter() const {
+    return (uint16_t)(this->get_cycles() - m_div_start);
+}
+
+uint64_t Timer::get_cycles() const {
+    return (m_scheduler != nullptr) ? m_scheduler->get_cycles() : m_cycles;
+}
+
+bool Timer::timer_enabled() const {
+    return (m_tac & 0x04) == 0x04;
+}
+
+// TIMA increments on the falling edge of bit 9, 3, 5 or 7 of the counter
+int Timer::get_timer_period() const {
+    switch (m_tac & 0x03) {
+        case 0x0:
+            return 1024;
+        case 0x1:
+            return 16;
+        case 0x2:
+            return 64;
+        case 0x3:
+        default:
+            return 256;
+    }
+}
+
+// Bring TIMA up to cycles, applying any overflows and reloads in between
+void Timer::sync(uint64_t cycles) {
+    uint64_t time = m_tima_synced;
+    uint64_t period = this->get_timer_period();
+
+    while (true) {
+        if (m_overflow_time != NO_EVENT) {
+            uint64_t reload_time = m_overflow_time + TIMER_RELOAD_DELAY;
+            if (reload_time > cycles) {
+                break;
+            }
+
+            m_tima = m_tma;
+            m_overflow_time = NO_EVENT;
+            m_memory_map.set_interrupt_flag_bit(TIMER, true);
+            time = reload_time;
+        }
+
+        if (!this->timer_enabled()) {
+            break;
+        }
+
+        // Falling edges in (time, cycles]
+        uint64_t edges = (cycles - m_div_start) / period - (time - m_div_start) / period;
+        if (m_tima + edges <= 0xFF) {
+            m_tima += edges;
+            break;
+        }
+
+        uint64_t overflow_edge = (time - m_div_start) / period + (0x100 - m_tima);
+        m_tima = 0x0;
+        m_overflow_time = m_div_start + overflow_edge * period;
+        time = m_overflow_time;
+    }
+
+    m_tima_synced = cycles;
+}
+
+void Timer::increment_tima(uint64_t cycles) {
+    if (m_tima == 0xFF) {
+        m_tima = 0x0;
+        m_overflow_time = cycles;
+    }
+    else {
+        m_tima++;
+    }
+}
+
+// The next overflow or reload, nothing is scheduled while the timer is stopped
+void Timer::schedule_next_event() {
+    if (m_scheduler == nullptr) {
+        return;
+    }
+
+    if (m_overflow_time != NO_EVENT) {
+        m_scheduler->schedule(EVENT_TIMER, m_overflow_time + TIMER_RELOAD_DELAY);
+    }
+    else if (this->timer_enabled()) {
+        uint64_t cycles = m_scheduler->get_cycles();
+        uint64_t period = this->get_timer_period();
+        uint64_t overflow_edge = (cycles - m_div_start) / period + (0x100 - m_tima);
+
+        m_scheduler->schedule(EVENT_TIMER, m_div_start + overflow_edge * period);
+    }
+    else {
+        m_scheduler->cancel(EVENT_TIMER);
     }
 }
@@ -2,17 +2,59 @@
 
 #include "../memory/memory_map.h"
 #include "../memory/mem_io.h"
+#include "../memory/io_listener.h"
+#include "../scheduler/scheduler.h"
 
 
-class Timer {
+// TIMA is loaded from TMA and the interrupt requested this many cycles after it overflows
+const int TIMER_RELOAD_DELAY = 4;
+
+
+// DIV, TIMA, TMA and TAC. Nothing runs per instruction, DIV and TIMA are
+// computed from the cycle count when they are read or written, and the only
+// scheduled events are TIMA overflows.
+class Timer : public IOListener, public EventHandler {
     public:
         Timer(MemoryMap &);
         virtual ~Timer();
 
+        // Advance by cycles when running without a scheduler
         void tick(int);
+
+        void set_scheduler(Scheduler *);
+        void handle_event(EventType_t, uint64_t) override;
+
+        void io_read(IORegisters_t) override;
+        void io_written(IORegisters_t, uint8_t) override;
+
+        uint16_t get_div_counter() const;
+
+        void save_state(StateWriter &);
+        void load_state(StateReader &);
     
     private:
         MemoryMap &m_memory_map;
 
-        int m_cycle_counter;
-};
\ No newline at end of file
+        Scheduler *m_scheduler;
+        uint64_t m_cycles;
+
+        // Cycle at which the 16 bit counter behind DIV was 0
+        uint64_t m_div_start;
+
+        uint8_t m_tima;
+        uint8_t m_tma;
+        uint8_t m_tac;
+
+        // TIMA is up to date as of this cycle
+        uint64_t m_tima_synced;
+        // Cycle at which TIMA overflowed, NO_EVENT when no reload is pending
+        uint64_t m_overflow_time;
+
+        uint64_t get_cycles() const;
+        bool timer_enabled() const;
+        int get_timer_period() const;
+
+        void sync(uint64_t);
+        void increment_tima(uint64_t);
+        void schedule_next_event();
+};
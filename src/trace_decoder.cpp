@@ -0,0 +1,59 @@
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "debugger/trace_logger.h"
+#include "debugger/disassembler.h"
+
+
+// Convert a binary trace written with --trace back into text
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <trace file> [--registers]" << std::endl;
+        return 1;
+    }
+
+    bool print_registers = (argc > 2 && std::string(argv[2]) == "--registers");
+
+    std::FILE *file = std::fopen(argv[1], "rb");
+    if (file == nullptr) {
+        std::cerr << "Could not open trace file " << argv[1] << std::endl;
+        return 1;
+    }
+
+    TraceHeader_t header;
+    if (std::fread(&header, sizeof(header), 1, file) != 1 || std::memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) != 0) {
+        std::cerr << "Not a trace file" << std::endl;
+        std::fclose(file);
+        return 1;
+    }
+
+    if (header.version != TRACE_VERSION || header.record_size != sizeof(TraceRecord_t)) {
+        std::cerr << "Unsupported trace version " << header.version << std::endl;
+        std::fclose(file);
+        return 1;
+    }
+
+    TraceRecord_t records[TRACE_WRITE_BATCH];
+    size_t count;
+    while ((count = std::fread(records, sizeof(TraceRecord_t), TRACE_WRITE_BATCH, file)) > 0) {
+        for (size_t i = 0; i < count; i++) {
+            const TraceRecord_t &record = records[i];
+            std::string mnemonic = disassemble(record.opcode, record.operands[0], record.operands[1]);
+
+            if (print_registers) {
+                std::printf("0x%X: (0x%X)%-20s AF=%04X BC=%04X DE=%04X HL=%04X SP=%04X CY=%llu\n",
+                    record.pc, record.opcode, mnemonic.c_str(),
+                    record.af, record.bc, record.de, record.hl, record.sp,
+                    (unsigned long long)record.cycle);
+            }
+            else {
+                std::printf("0x%X: (0x%X)%s\n", record.pc, record.opcode, mnemonic.c_str());
+            }
+        }
+    }
+
+    std::fclose(file);
+    return 0;
+}
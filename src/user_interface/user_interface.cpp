@@ -5,7 +5,10 @@ UI::UI(MemoryMap &mem_map, bool headless):
 m_memory_map(mem_map),
 m_display_open(false),
 m_display_initialized(false),
-m_headless(headless)
+m_headless(headless),
+m_speed_requested(false),
+m_requested_speed(1.0),
+m_rewind_requested(false)
 {
 
 }
@@ -22,10 +25,36 @@ void UI::render(FrameBuffer &buffer) {
 
 }
 
+bool UI::take_button_event(ButtonEvent_t &) {
+    return false;
+}
+
 void UI::set_button_pressed(Buttons_t key, bool pressed) {
     m_memory_map.set_button_pressed(key, pressed);
 }
 
+void UI::request_speed(double speed) {
+    m_requested_speed.store(speed, std::memory_order_relaxed);
+    m_speed_requested.store(true, std::memory_order_release);
+}
+
+bool UI::take_speed_request(double &speed) {
+    if (!m_speed_requested.exchange(false, std::memory_order_acquire)) {
+        return false;
+    }
+
+    speed = m_requested_speed.load(std::memory_order_relaxed);
+    return true;
+}
+
+void UI::request_rewind() {
+    m_rewind_requested.store(true, std::memory_order_release);
+}
+
+bool UI::take_rewind_request() {
+    return m_rewind_requested.exchange(false, std::memory_order_acquire);
+}
+
 void UI::set_display_initialized(bool initialized) {
     m_display_initialized = initialized;
 }
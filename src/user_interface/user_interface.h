@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include <atomic>
 
 #include "../video/framebuffer.h"
 #include "../memory/memory_map.h"
@@ -14,8 +15,20 @@ class UI {
         virtual void init_display(const std::string &);
         virtual void render(FrameBuffer &);
 
+        // Next button change from the display, taken by the emulation thread which
+        // applies it to the joypad. Returns false when there is none.
+        virtual bool take_button_event(ButtonEvent_t &);
+
         void set_button_pressed(Buttons_t, bool);
 
+        // Emulation speed chosen in the display, taken once by the emulation thread
+        void request_speed(double);
+        bool take_speed_request(double &);
+
+        // Step back to the previous rewind snapshot, taken once by the emulation thread
+        void request_rewind();
+        bool take_rewind_request();
+
         bool is_display_initialized() const;
         void set_display_initialized(bool);
 
@@ -28,7 +41,12 @@ class UI {
     protected:
         MemoryMap &m_memory_map;
 
-        bool m_display_open;
+        // Cleared by the display thread when the window is closed
+        std::atomic<bool> m_display_open;
         bool m_display_initialized;
         bool m_headless;
+
+        std::atomic<bool> m_speed_requested;
+        std::atomic<double> m_requested_speed;
+        std::atomic<bool> m_rewind_requested;
 };
\ No newline at end of file
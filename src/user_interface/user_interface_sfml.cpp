@@ -2,23 +2,79 @@
 
 
 UI_SFML::UI_SFML(MemoryMap &mem_map, bool headless):
-UI(mem_map, headless)
+UI(mem_map, headless),
+m_frames(FrameBuffer(LCD_WIDTH, LCD_HEIGHT)),
+m_title(""),
+m_main_window(nullptr),
+m_texture_created(false)
 {
 
 }
 
 UI_SFML::~UI_SFML() {
-    if (this->is_display_initialized()) {
-        delete m_main_window;
+    this->set_display_enabled(false);
+
+    if (m_render_thread.joinable()) {
+        m_render_thread.join();
     }
 }
 
 void UI_SFML::init_display(const std::string &title) {
+    this->set_display_enabled(true);
+
     if (this->is_headless()) {
-        this->set_display_enabled(true);
         return;
     }
 
+    m_title = title;
+    this->set_display_initialized(true);
+
+    m_render_thread = std::thread(&UI_SFML::render_loop, this);
+}
+
+void UI_SFML::render(FrameBuffer &buffer) {
+    if (this->is_headless() || !this->is_display_initialized()) return;
+
+    // Rows are contiguous, only the colour indices cross threads and the render thread
+    // converts them to RGBA
+    FrameBuffer &frame = m_frames.get_write_buffer();
+    std::memcpy(frame.get_row(0), buffer.get_row(0), LCD_WIDTH * LCD_HEIGHT);
+    m_frames.publish();
+}
+
+bool UI_SFML::take_button_event(ButtonEvent_t &event) {
+    return m_button_events.pop(&event, 1) == 1;
+}
+
+// Present the newest complete frame until the window is closed or the UI is destroyed.
+// The window is created here, SFML windows must be used from the thread that created them.
+void UI_SFML::render_loop() {
+    this->open_window();
+
+    while (this->is_display_enabled()) {
+        this->poll_events();
+
+        if (!this->is_display_enabled()) {
+            break;
+        }
+
+        if (m_frames.update()) {
+            FrameBuffer &frame = m_frames.get_read_buffer();
+            frame.update_rgba();
+            this->update_texture(frame);
+        }
+
+        m_main_window->clear();
+        m_main_window->draw(m_sprite);
+        m_main_window->display();
+    }
+
+    m_main_window->close();
+    delete m_main_window;
+    m_main_window = nullptr;
+}
+
+void UI_SFML::open_window() {
     sf::VideoMode window_bounds(PIXEL_SIZE * LCD_WIDTH, PIXEL_SIZE * LCD_HEIGHT);
     bool fullscreen = false;
     unsigned framerate_limit = 60;
@@ -28,36 +84,21 @@ void UI_SFML::init_display(const std::string &title) {
     m_window_settings.antialiasingLevel = antialiasing_level;
 
     if (fullscreen) {
-        m_main_window = new sf::RenderWindow(window_bounds, title, sf::Style::Fullscreen, m_window_settings);
+        m_main_window = new sf::RenderWindow(window_bounds, m_title, sf::Style::Fullscreen, m_window_settings);
     }
     else {
-        m_main_window = new sf::RenderWindow(window_bounds, title, sf::Style::Titlebar | sf::Style::Close, m_window_settings);
+        m_main_window = new sf::RenderWindow(window_bounds, m_title, sf::Style::Titlebar | sf::Style::Close, m_window_settings);
     }
 
+    // Only throttles the render thread
     m_main_window->setFramerateLimit(framerate_limit);
     m_main_window->setVerticalSyncEnabled(vertical_sync_enabled);
     m_main_window->setKeyRepeatEnabled(false);
 
-    m_image.create(PIXEL_SIZE * LCD_WIDTH, PIXEL_SIZE * LCD_HEIGHT);
-
-    this->set_display_enabled(true);
-    this->set_display_initialized(true);
-}
-
-void UI_SFML::render(FrameBuffer &buffer) {
-    if (this->is_headless()) return;
-
-    this->poll_events();
-
-    m_main_window->clear();
-    
-    this->draw_pixels(buffer);
-    m_texture.loadFromImage(m_image);
-    m_sprite.setTexture(m_texture, true);
-
-    m_main_window->draw(m_sprite);
-
-    m_main_window->display();
+    if (this->create_texture()) {
+        m_sprite.setTexture(m_texture, true);
+        m_sprite.setScale(PIXEL_SIZE, PIXEL_SIZE);
+    }
 }
 
 void UI_SFML::poll_events() {
@@ -66,10 +107,15 @@ void UI_SFML::poll_events() {
     while (m_main_window->pollEvent(event)) {
         if (event.type == sf::Event::Closed) {
             this->set_display_enabled(false);
-            m_main_window->close();
         }
         else if (event.type == sf::Event::KeyPressed) {
             sf::Keyboard::Key key = event.key.code;
+            this->set_speed_key_pressed(key);
+
+            if (key == sf::Keyboard::Key::R) {
+                this->request_rewind();
+            }
+
             this->set_key_pressed(key, true);
         }
         else if (event.type == sf::Event::KeyReleased) {
@@ -79,64 +125,96 @@ void UI_SFML::poll_events() {
     }
 }
 
-void UI_SFML::draw_pixels(FrameBuffer &buffer) {
-    for (int y = 0; y < LCD_HEIGHT; y++) {
-        for (int x = 0; x < LCD_WIDTH; x++) {
-            Colour_t colour = buffer.get_pixel(x, y);
-            sf::Color pixel_colour = this->get_pixel_colour(colour);
-            this->set_pixel(x, y, pixel_colour);
-        }
-    }    
+bool UI_SFML::update_texture(FrameBuffer &buffer) {
+    if (!this->create_texture()) {
+        return false;
+    }
+
+    // Once enabled the owner of the buffer keeps the RGBA plane current
+    if (!buffer.is_rgba_enabled()) {
+        buffer.set_rgba_enabled(true);
+    }
+
+    m_texture.update(buffer.get_rgba());
+
+    return true;
 }
 
-void UI_SFML::set_pixel(int x, int y, sf::Color colour) {
-    for (int h = 0; h < PIXEL_SIZE; h++) {
-        for (int w = 0; w < PIXEL_SIZE; w++) {
-            m_image.setPixel(x * PIXEL_SIZE + w, y * PIXEL_SIZE + h, colour);
-        }
+bool UI_SFML::create_texture() {
+    if (m_texture_created) {
+        return true;
+    }
+
+    if (!m_texture.create(LCD_WIDTH, LCD_HEIGHT)) {
+        log_warn("Could not create a %dx%d texture", LCD_WIDTH, LCD_HEIGHT);
+        return false;
+    }
+
+    // Keep the pixels sharp when the sprite scales the texture up
+    m_texture.setSmooth(false);
+    m_texture_created = true;
+
+    return true;
+}
+
+// 1: real time, 2: 2x, 3: 4x, 4: half speed, 0: unthrottled
+void UI_SFML::set_speed_key_pressed(sf::Keyboard::Key key) {
+    switch (key) {
+        case sf::Keyboard::Key::Num1:
+            this->request_speed(1.0);
+            break;
+        case sf::Keyboard::Key::Num2:
+            this->request_speed(2.0);
+            break;
+        case sf::Keyboard::Key::Num3:
+            this->request_speed(4.0);
+            break;
+        case sf::Keyboard::Key::Num4:
+            this->request_speed(0.5);
+            break;
+        case sf::Keyboard::Key::Num0:
+            this->request_speed(0.0);
+            break;
+        default:
+            break;
     }
 }
 
 void UI_SFML::set_key_pressed(sf::Keyboard::Key key, bool pressed) {
+    Buttons_t button;
+
     switch (key) {
         case sf::Keyboard::Key::W:
-            this->set_button_pressed(UP, pressed);
+            button = UP;
             break;
         case sf::Keyboard::Key::A:
-            this->set_button_pressed(LEFT, pressed);
+            button = LEFT;
             break;
         case sf::Keyboard::Key::S:
-            this->set_button_pressed(DOWN, pressed);
+            button = DOWN;
             break;
         case sf::Keyboard::Key::D:
-            this->set_button_pressed(RIGHT, pressed);
+            button = RIGHT;
             break;
         case sf::Keyboard::Key::Comma:
-            this->set_button_pressed(A, pressed);
+            button = A;
             break;
         case sf::Keyboard::Key::Period:
-            this->set_button_pressed(B, pressed);
+            button = B;
             break;
         case sf::Keyboard::Key::Return:
-            this->set_button_pressed(START, pressed);
+            button = START;
             break;
         case sf::Keyboard::Key::BackSpace:
-            this->set_button_pressed(SELECT, pressed);
+            button = SELECT;
             break;
+        default:
+            return;
     }
-}
 
-sf::Color UI_SFML::get_pixel_colour(Colour_t colour) {
-    switch (colour) {
-        case WHITE:
-            return sf::Color(255, 255, 255);
-        case LIGHT_GRAY:
-            return sf::Color(170, 170, 170);
-        case DARK_GRAY:
-            return sf::Color(85, 85, 85);
-        case BLACK:
-            return sf::Color(0, 0, 0);
-        default:
-            return sf::Color(255, 255, 255);
-        }
-}
\ No newline at end of file
+    // The joypad belongs to the emulation thread, GameBoy takes the event from there
+    ButtonEvent_t event = {button, pressed};
+    if (!m_button_events.push(event)) {
+        log_warn("Button event queue full, dropping input");
+    }
+}
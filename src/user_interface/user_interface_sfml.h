@@ -1,15 +1,25 @@
 #pragma once
 
 #include <iostream>
+#include <string>
+#include <thread>
 #include <SFML/Graphics.hpp>
 
 #include "../video/framebuffer.h"
 #include "../video/definitions.h"
 #include "../memory/memory_map.h"
+#include "../utils/ring_buffer.h"
+#include "../utils/triple_buffer.h"
 
 #include "user_interface.h"
 
 
+// Key presses and releases from the window, applied to the joypad on the emulation thread
+const size_t BUTTON_EVENT_QUEUE_SIZE = 64;
+
+
+// The window lives on its own render thread. render() only copies the finished frame
+// into a triple buffer, so the emulator never waits on the framerate limit or on events.
 class UI_SFML : public UI {
     public:
         UI_SFML(MemoryMap &, bool=false);
@@ -17,20 +27,36 @@ class UI_SFML : public UI {
 
         void init_display(const std::string &);
 
+        // Hand the frame to the render thread, never blocks
         void render(FrameBuffer &);
+        bool take_button_event(ButtonEvent_t &) override;
+
+        // Upload the frame's RGBA plane to the LCD sized texture, works without a window.
+        // Returns false if the texture could not be created.
+        bool update_texture(FrameBuffer &);
 
     private:
+        void render_loop();
+        void open_window();
         void poll_events();
-        void draw_pixels(FrameBuffer &);
-        void set_pixel(int, int, sf::Color);
+        bool create_texture();
 
         void set_key_pressed(sf::Keyboard::Key, bool);
+        void set_speed_key_pressed(sf::Keyboard::Key);
+
+        // Emulation thread to render thread
+        TripleBuffer<FrameBuffer> m_frames;
+        RingBuffer<ButtonEvent_t, BUTTON_EVENT_QUEUE_SIZE> m_button_events;
+
+        std::string m_title;
+        std::thread m_render_thread;
 
-        sf::Color get_pixel_colour(Colour_t);
+        // Owned by the render thread
         sf::RenderWindow *m_main_window;
         sf::ContextSettings m_window_settings;
 
-        sf::Image m_image;
+        // LCD_WIDTH x LCD_HEIGHT, the sprite scales it up by PIXEL_SIZE
         sf::Texture m_texture;
         sf::Sprite m_sprite;
+        bool m_texture_created;
 };
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "frame_pacer.h"
+
+
+FramePacer::FramePacer(double cycles_per_second):
+m_cycles_per_second(cycles_per_second),
+m_speed(1.0),
+m_started(false),
+m_start_cycles(0),
+m_paced_frames(0),
+m_total_drift_ns(0),
+m_max_drift_ns(0),
+m_resync_count(0)
+{
+
+}
+
+FramePacer::~FramePacer() {
+
+}
+
+void FramePacer::set_speed(double speed) {
+    if (speed < 0) {
+        speed = PACER_UNTHROTTLED;
+    }
+
+    // The next wait starts pacing at the new speed from wherever emulation is then
+    m_speed = speed;
+    m_started = false;
+}
+
+double FramePacer::get_speed() const {
+    return m_speed;
+}
+
+void FramePacer::wait(uint64_t cycles) {
+    if (m_speed == PACER_UNTHROTTLED) {
+        return;
+    }
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    if (!m_started || cycles < m_start_cycles) {
+        this->restart(cycles, now);
+        return;
+    }
+
+    // Computed from the start point every time so rounding never accumulates
+    double seconds = (double)(cycles - m_start_cycles) / (m_cycles_per_second * m_speed);
+    std::chrono::steady_clock::time_point target = m_start_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+
+    int64_t behind_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - target).count();
+    if (behind_ns > PACER_MAX_LAG_NS) {
+        this->restart(cycles, now);
+        m_resync_count++;
+        return;
+    }
+
+    std::chrono::nanoseconds spin(PACER_SPIN_NS);
+    if (target - now > spin) {
+        std::this_thread::sleep_for(target - now - spin);
+    }
+
+    while ((now = std::chrono::steady_clock::now()) < target) {
+        std::this_thread::yield();
+    }
+
+    int64_t drift_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - target).count();
+    m_total_drift_ns += drift_ns;
+    m_max_drift_ns = std::max(m_max_drift_ns, drift_ns);
+    m_paced_frames++;
+}
+
+int64_t FramePacer::get_average_drift_ns() const {
+    if (m_paced_frames == 0) {
+        return 0;
+    }
+
+    return m_total_drift_ns / (int64_t)m_paced_frames;
+}
+
+int64_t FramePacer::get_max_drift_ns() const {
+    return m_max_drift_ns;
+}
+
+uint64_t FramePacer::get_resync_count() const {
+    return m_resync_count;
+}
+
+void FramePacer::restart(uint64_t cycles, std::chrono::steady_clock::time_point now) {
+    m_start_cycles = cycles;
+    m_start_time = now;
+    m_started = true;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+
+// Sleep until this close to the target, then spin, sleeps overshoot by up to a scheduler tick
+const int64_t PACER_SPIN_NS = 2000000;
+// Further behind than this and the pacer starts again from now instead of catching up
+const int64_t PACER_MAX_LAG_NS = 100000000;
+
+// Speed 0 runs as fast as possible
+const double PACER_UNTHROTTLED = 0.0;
+
+
+// Keeps emulated time in step with real time. wait() is given the emulated cycle
+// count and blocks until the wall clock reaches it, scaled by the current speed.
+class FramePacer {
+    public:
+        // Emulated cycles per second at real time
+        FramePacer(double);
+        virtual ~FramePacer();
+
+        // 1.0 is real time, 2.0 twice as fast, 0.5 half speed, PACER_UNTHROTTLED no waiting
+        void set_speed(double);
+        double get_speed() const;
+
+        void wait(uint64_t);
+
+        // How late wait() returned compared to its target, averaged over every paced frame
+        int64_t get_average_drift_ns() const;
+        int64_t get_max_drift_ns() const;
+        // Times the pacer fell too far behind and started again from the current time
+        uint64_t get_resync_count() const;
+
+    private:
+        double m_cycles_per_second;
+        double m_speed;
+
+        // Wall clock time the emulated cycle count m_start_cycles is paced against
+        bool m_started;
+        uint64_t m_start_cycles;
+        std::chrono::steady_clock::time_point m_start_time;
+
+        uint64_t m_paced_frames;
+        int64_t m_total_drift_ns;
+        int64_t m_max_drift_ns;
+        uint64_t m_resync_count;
+
+        void restart(uint64_t, std::chrono::steady_clock::time_point);
+};
@@ -0,0 +1,145 @@
+#include "rewind_buffer.h"
+
+
+RewindBuffer::RewindBuffer(size_t max_snapshots, size_t max_bytes):
+m_max_snapshots(max_snapshots),
+m_max_bytes(max_bytes),
+m_delta_bytes(0)
+{
+
+}
+
+RewindBuffer::~RewindBuffer() {
+
+}
+
+void RewindBuffer::push(std::vector<uint8_t> &snapshot) {
+    // A different size means a different layout, nothing older can be rebuilt from it
+    if (!m_current.empty() && m_current.size() != snapshot.size()) {
+        this->clear();
+    }
+
+    if (!m_current.empty()) {
+        m_deltas.push_back(std::vector<uint8_t>());
+        encode_delta(snapshot, m_current, m_deltas.back());
+        m_delta_bytes += m_deltas.back().size();
+    }
+
+    m_current.swap(snapshot);
+
+    while (!m_deltas.empty() && (m_deltas.size() + 1 > m_max_snapshots || m_current.size() + m_delta_bytes > m_max_bytes)) {
+        m_delta_bytes -= m_deltas.front().size();
+        m_deltas.pop_front();
+    }
+}
+
+bool RewindBuffer::pop(std::vector<uint8_t> &snapshot) {
+    if (m_current.empty()) {
+        return false;
+    }
+
+    snapshot = m_current;
+
+    if (m_deltas.empty()) {
+        m_current.clear();
+        return true;
+    }
+
+    apply_delta(m_deltas.back(), m_current);
+    m_delta_bytes -= m_deltas.back().size();
+    m_deltas.pop_back();
+
+    return true;
+}
+
+void RewindBuffer::clear() {
+    m_current.clear();
+    m_deltas.clear();
+    m_delta_bytes = 0;
+}
+
+size_t RewindBuffer::get_num_snapshots() const {
+    return m_current.empty() ? 0 : m_deltas.size() + 1;
+}
+
+size_t RewindBuffer::get_size_bytes() const {
+    return m_current.size() + m_delta_bytes;
+}
+
+// Delta turning newer back into older, both the same size
+void RewindBuffer::encode_delta(const std::vector<uint8_t> &newer, const std::vector<uint8_t> &older, std::vector<uint8_t> &delta) {
+    const uint8_t *a = newer.data();
+    const uint8_t *b = older.data();
+    size_t size = newer.size();
+    size_t i = 0;
+
+    delta.clear();
+
+    while (i < size) {
+        // Unchanged run, compared a word at a time
+        size_t start = i;
+        while (i + sizeof(uint64_t) <= size) {
+            uint64_t x;
+            uint64_t y;
+            std::memcpy(&x, a + i, sizeof(x));
+            std::memcpy(&y, b + i, sizeof(y));
+            if (x != y) {
+                break;
+            }
+            i += sizeof(uint64_t);
+        }
+        while (i < size && a[i] == b[i]) {
+            i++;
+        }
+
+        // Nothing needs writing for the unchanged end
+        if (i == size) {
+            break;
+        }
+
+        size_t run = i - start;
+        while (run > 0) {
+            size_t length = std::min(run, (size_t)REWIND_MAX_TOKEN_LENGTH);
+            delta.push_back(REWIND_ZERO_RUN | (length - 1));
+            run -= length;
+        }
+
+        // Changed bytes, up to the next unchanged one
+        start = i;
+        while (i < size && a[i] != b[i]) {
+            i++;
+        }
+
+        size_t position = start;
+        while (position < i) {
+            size_t length = std::min(i - position, (size_t)REWIND_MAX_TOKEN_LENGTH);
+            delta.push_back(length - 1);
+            for (size_t j = 0; j < length; j++) {
+                delta.push_back(a[position + j] ^ b[position + j]);
+            }
+            position += length;
+        }
+    }
+}
+
+void RewindBuffer::apply_delta(const std::vector<uint8_t> &delta, std::vector<uint8_t> &snapshot) {
+    uint8_t *output = snapshot.data();
+    size_t position = 0;
+    size_t i = 0;
+
+    while (i < delta.size()) {
+        uint8_t control = delta[i++];
+        size_t length = (control & 0x7F) + 1;
+
+        if (control & REWIND_ZERO_RUN) {
+            position += length;
+            continue;
+        }
+
+        for (size_t j = 0; j < length; j++) {
+            output[position + j] ^= delta[i + j];
+        }
+        position += length;
+        i += length;
+    }
+}
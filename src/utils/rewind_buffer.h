@@ -0,0 +1,48 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+
+// Delta tokens: a control byte below 0x80 is followed by that many plus one XOR bytes,
+// 0x80 and above stands for (control & 0x7F) plus one unchanged bytes
+const int REWIND_MAX_TOKEN_LENGTH = 0x80;
+const uint8_t REWIND_ZERO_RUN = 0x80;
+
+
+// History of equally sized snapshots, newest kept in full. Older ones are stored as the
+// XOR with the snapshot after them, run-length encoded, so unchanged memory costs
+// almost nothing. The oldest snapshots are dropped past either limit.
+class RewindBuffer {
+    public:
+        RewindBuffer(size_t, size_t);
+        virtual ~RewindBuffer();
+
+        // Takes the contents of the snapshot, which is left holding a previous snapshot's
+        // buffer so the caller can reuse it without allocating
+        void push(std::vector<uint8_t> &);
+
+        // Newest snapshot, which is then removed. Returns false when empty.
+        bool pop(std::vector<uint8_t> &);
+
+        void clear();
+
+        size_t get_num_snapshots() const;
+        // Bytes held by the newest snapshot and every delta
+        size_t get_size_bytes() const;
+
+    private:
+        size_t m_max_snapshots;
+        size_t m_max_bytes;
+
+        std::vector<uint8_t> m_current;
+        // Applying the back delta to m_current gives the snapshot before it
+        std::deque<std::vector<uint8_t>> m_deltas;
+        size_t m_delta_bytes;
+
+        static void encode_delta(const std::vector<uint8_t> &, const std::vector<uint8_t> &, std::vector<uint8_t> &);
+        static void apply_delta(const std::vector<uint8_t> &, std::vector<uint8_t> &);
+};
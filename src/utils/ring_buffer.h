@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+
+// Lock-free queue for exactly one producer thread and one consumer thread.
+// N must be a power of two, one slot is never used to tell full from empty.
+template <typename T, size_t N>
+class RingBuffer {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "RingBuffer size must be a power of two");
+
+    public:
+        RingBuffer():
+        m_head(0),
+        m_tail(0)
+        {
+
+        }
+
+        // Producer side, returns false if the buffer is full
+        bool push(const T &item) {
+            size_t head = m_head.load(std::memory_order_relaxed);
+            size_t next = (head + 1) & (N - 1);
+            if (next == m_tail.load(std::memory_order_acquire)) {
+                return false;
+            }
+
+            m_items[head] = item;
+            m_head.store(next, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side, copies up to max items out and returns how many were taken
+        size_t pop(T *items, size_t max) {
+            size_t tail = m_tail.load(std::memory_order_relaxed);
+            size_t head = m_head.load(std::memory_order_acquire);
+
+            size_t count = 0;
+            while (tail != head && count < max) {
+                items[count++] = m_items[tail];
+                tail = (tail + 1) & (N - 1);
+            }
+
+            m_tail.store(tail, std::memory_order_release);
+            return count;
+        }
+
+        bool empty() const {
+            return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+        }
+
+    private:
+        // Keep the indices on separate cache lines so the two threads do not share one
+        alignas(64) std::atomic<size_t> m_head;
+        alignas(64) std::atomic<size_t> m_tail;
+        alignas(64) T m_items[N];
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+// Appends component state to a byte vector. Values are copied in host byte order,
+// like binary traces, so a state is loaded on the same kind of machine that saved it.
+class StateWriter {
+    public:
+        StateWriter(std::vector<uint8_t> &data):
+        m_data(data)
+        {
+
+        }
+
+        void write_bytes(const void *bytes, size_t size) {
+            const uint8_t *begin = static_cast<const uint8_t *>(bytes);
+            m_data.insert(m_data.end(), begin, begin + size);
+        }
+
+        // Integers, bools, enums and plain structs
+        template <typename T>
+        void write(const T &value) {
+            this->write_bytes(&value, sizeof(T));
+        }
+
+        void write_string(const std::string &value) {
+            this->write<uint32_t>(value.size());
+            this->write_bytes(value.data(), value.size());
+        }
+
+        void write_vector(const std::vector<uint8_t> &value) {
+            this->write<uint32_t>(value.size());
+            this->write_bytes(value.data(), value.size());
+        }
+
+    private:
+        std::vector<uint8_t> &m_data;
+};
+
+
+// Reads back what a StateWriter wrote, in the same order
+class StateReader {
+    public:
+        StateReader(const std::vector<uint8_t> &data):
+        m_data(data),
+        m_position(0)
+        {
+
+        }
+
+        void read_bytes(void *bytes, size_t size) {
+            if (size > m_data.size() - m_position) {
+                std::cerr << "Save state truncated at byte " << m_position << std::endl;
+                throw new std::exception;
+            }
+
+            std::memcpy(bytes, m_data.data() + m_position, size);
+            m_position += size;
+        }
+
+        template <typename T>
+        void read(T &value) {
+            this->read_bytes(&value, sizeof(T));
+        }
+
+        template <typename T>
+        T read() {
+            T value;
+            this->read(value);
+            return value;
+        }
+
+        std::string read_string() {
+            uint32_t size = this->read_size();
+            std::string value(reinterpret_cast<const char *>(m_data.data() + m_position), size);
+            m_position += size;
+            return value;
+        }
+
+        std::vector<uint8_t> read_vector() {
+            uint32_t size = this->read_size();
+            std::vector<uint8_t> value(m_data.begin() + m_position, m_data.begin() + m_position + size);
+            m_position += size;
+            return value;
+        }
+
+        bool at_end() const {
+            return m_position == m_data.size();
+        }
+
+    private:
+        const std::vector<uint8_t> &m_data;
+        size_t m_position;
+
+        // Length prefix of a string or vector, checked against the bytes left
+        uint32_t read_size() {
+            uint32_t size = this->read<uint32_t>();
+            if (size > m_data.size() - m_position) {
+                std::cerr << "Save state truncated at byte " << m_position << std::endl;
+                throw new std::exception;
+            }
+
+            return size;
+        }
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+
+
+// Slot index in the low bits of the shared index, the high bit marks a slot published
+// since the consumer last took one
+const int TRIPLE_BUFFER_INDEX_MASK = 0x03;
+const int TRIPLE_BUFFER_FRESH = 0x04;
+
+
+// Lock-free hand-off of the newest item from exactly one producer thread to exactly one
+// consumer thread. The producer fills the back slot and publishes it, the consumer takes
+// whichever slot was published last. Neither side ever waits for the other, items the
+// consumer was too slow to take are overwritten.
+template <typename T>
+class TripleBuffer {
+    public:
+        TripleBuffer(const T &initial):
+        m_slots{initial, initial, initial},
+        m_back(0),
+        m_middle(1),
+        m_front(2)
+        {
+
+        }
+
+        // Producer side, the slot to fill next
+        T &get_write_buffer() {
+            return m_slots[m_back];
+        }
+
+        // Producer side, swap the filled slot with the shared one
+        void publish() {
+            int previous = m_middle.exchange(m_back | TRIPLE_BUFFER_FRESH, std::memory_order_acq_rel);
+            m_back = previous & TRIPLE_BUFFER_INDEX_MASK;
+        }
+
+        // Consumer side, take the newest published slot. Returns false if nothing
+        // was published since the last call, the read slot is then unchanged.
+        bool update() {
+            if (!(m_middle.load(std::memory_order_relaxed) & TRIPLE_BUFFER_FRESH)) {
+                return false;
+            }
+
+            int previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+            m_front = previous & TRIPLE_BUFFER_INDEX_MASK;
+            return true;
+        }
+
+        // Consumer side, the slot taken by the last update
+        T &get_read_buffer() {
+            return m_slots[m_front];
+        }
+
+    private:
+        T m_slots[3];
+
+        // Only the producer touches m_back and only the consumer touches m_front,
+        // the shared index sits on its own cache line
+        alignas(64) int m_back;
+        alignas(64) std::atomic<int> m_middle;
+        alignas(64) int m_front;
+};
@@ -9,6 +9,8 @@ const int OAM_CLOCKS = 4 * 80;              // Mode 2
 const int DATA_TRANSFER_CLOCKS = 4 * 172;   // Mode 3
 
 const int VBLANK_SCANLINE_CLOCKS = VBLANK_CLOCKS / 10;
+// One full frame, 144 drawn lines then VBlank
+const int FRAME_CLOCKS = 144 * (OAM_CLOCKS + DATA_TRANSFER_CLOCKS + HBLANK_CLOCKS) + VBLANK_CLOCKS;
 
 const int LCD_WIDTH = 160;
 const int LCD_HEIGHT = 144;
@@ -31,6 +33,7 @@ const int TILE_DATA_ENTIRE_SET_BYTES = 6143;
 
 const int NUM_SPRITES = 40;
 const int SPRITE_BYTES = 4;
+const int MAX_SPRITES_PER_LINE = 10;
 
 
 typedef enum SpriteSize {
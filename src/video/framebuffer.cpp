@@ -1,22 +1,31 @@
 #include "framebuffer.h"
 
 
+// R, G, B, A for each Colour_t
+static const uint8_t s_rgba_colours[4][RGBA_PIXEL_BYTES] = {
+    {255, 255, 255, 255},
+    {170, 170, 170, 255},
+    {85, 85, 85, 255},
+    {0, 0, 0, 255}
+};
+
+
 FrameBuffer::FrameBuffer(int w, int h):
+m_buffer(w * h, WHITE),
 m_width(w),
-m_height(h)
+m_height(h),
+m_rgba_enabled(false)
 {
-    for (int i = 0; i < (w * h); i++) {
-        m_buffer.push_back(WHITE);
-    }
+
 }
 
 FrameBuffer::~FrameBuffer() {
 
 }
 
-Colour_t FrameBuffer::get_pixel(int x, int y) {
+Colour_t FrameBuffer::get_pixel(int x, int y) const {
     int index = y * m_width + x;
-    return m_buffer[index];
+    return (Colour_t)m_buffer[index];
 }
 
 void FrameBuffer::set_pixel(int x, int y, Colour_t colour) {
@@ -24,10 +33,78 @@ void FrameBuffer::set_pixel(int x, int y, Colour_t colour) {
     m_buffer[index] = colour;
 }
 
+uint8_t *FrameBuffer::get_row(int y) {
+    return &m_buffer[y * m_width];
+}
+
+const uint8_t *FrameBuffer::get_row(int y) const {
+    return &m_buffer[y * m_width];
+}
+
+int FrameBuffer::get_width() const {
+    return m_width;
+}
+
+int FrameBuffer::get_height() const {
+    return m_height;
+}
+
 void FrameBuffer::reset() {
+    std::memset(m_buffer.data(), WHITE, m_buffer.size());
+}
+
+void FrameBuffer::set_rgba_enabled(bool enabled) {
+    m_rgba_enabled = enabled;
+
+    if (enabled) {
+        m_rgba.resize(m_buffer.size() * RGBA_PIXEL_BYTES);
+        this->update_rgba();
+    }
+    else {
+        std::vector<uint8_t>().swap(m_rgba);
+    }
+}
+
+bool FrameBuffer::is_rgba_enabled() const {
+    return m_rgba_enabled;
+}
+
+void FrameBuffer::update_rgba() {
+    if (!m_rgba_enabled) {
+        return;
+    }
+
+    // Whole pixels are copied as 32 bit words, the byte order in memory stays R, G, B, A
+    uint32_t colours[4];
+    std::memcpy(colours, s_rgba_colours, sizeof(colours));
+
+    const uint8_t *input = m_buffer.data();
+    uint8_t *output = m_rgba.data();
+    size_t size = m_buffer.size();
+    for (size_t i = 0; i < size; i++) {
+        std::memcpy(output + i * RGBA_PIXEL_BYTES, &colours[input[i] & 0x03], RGBA_PIXEL_BYTES);
+    }
+}
+
+const uint8_t *FrameBuffer::get_rgba() const {
+    return m_rgba_enabled ? m_rgba.data() : nullptr;
+}
+
+void FrameBuffer::save_ppm(const std::string &file_name) const {
+    std::ofstream file(file_name, std::ios::binary);
+    if (!file) {
+        std::cerr << "Could not open screenshot file " << file_name << std::endl;
+        throw new std::exception;
+    }
+
+    file << "P6\n" << m_width << " " << m_height << "\n255\n";
+
+    std::vector<char> row(m_width * 3);
     for (int y = 0; y < m_height; y++) {
+        const uint8_t *pixels = this->get_row(y);
         for (int x = 0; x < m_width; x++) {
-            this->set_pixel(x, y, WHITE);
+            std::memcpy(&row[x * 3], s_rgba_colours[pixels[x] & 0x03], 3);
         }
+        file.write(row.data(), row.size());
     }
-}
\ No newline at end of file
+}
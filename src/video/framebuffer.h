@@ -1,23 +1,53 @@
 #pragma once
 
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
 #include <vector>
 
 #include "definitions.h"
 
 
+// Bytes per pixel of the RGBA output plane
+const int RGBA_PIXEL_BYTES = 4;
+
+
+// One Colour_t per byte, rows stored contiguously. An RGBA copy can be
+// produced for front-ends that upload the frame directly.
 class FrameBuffer {
     public:
         FrameBuffer(int, int);
         virtual ~FrameBuffer();
 
-        Colour_t get_pixel(int, int);
+        Colour_t get_pixel(int, int) const;
         void set_pixel(int, int, Colour_t);
 
+        // Row spans of width pixels
+        uint8_t *get_row(int);
+        const uint8_t *get_row(int) const;
+
+        int get_width() const;
+        int get_height() const;
+
         void reset();
+
+        // The RGBA plane is only kept up to date while enabled
+        void set_rgba_enabled(bool);
+        bool is_rgba_enabled() const;
+        void update_rgba();
+        const uint8_t *get_rgba() const;
+
+        // Binary PPM (P6) image of the frame
+        void save_ppm(const std::string &) const;
     
     private:
-        std::vector<Colour_t> m_buffer;
+        std::vector<uint8_t> m_buffer;
+        std::vector<uint8_t> m_rgba;
 
         int m_width;
         int m_height;
-};
\ No newline at end of file
+
+        bool m_rgba_enabled;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+#include "definitions.h"
+
+
+// BGP, OBP0 and OBP1 decoded to a colour per colour index. MemoryMap updates
+// them when the registers are written so the renderer only does a lookup.
+class PaletteCache {
+    public:
+        PaletteCache() {
+            this->update_background(0x0);
+            this->update_sprite(OBJECT_PALETTE_0, 0x0);
+            this->update_sprite(OBJECT_PALETTE_1, 0x0);
+        }
+
+        void update_background(uint8_t data) {
+            decode(data, m_background);
+        }
+
+        // Colour 0 is transparent for sprites, it is never drawn
+        void update_sprite(ObjectPalette_t palette, uint8_t data) {
+            decode(data, m_sprites[palette]);
+            m_sprites[palette][Colour0] = WHITE;
+        }
+
+        const Colour_t *get_background() const {
+            return m_background;
+        }
+
+        const Colour_t *get_sprite(ObjectPalette_t palette) const {
+            return m_sprites[palette];
+        }
+
+    private:
+        static void decode(uint8_t data, Colour_t *colours) {
+            for (int i = 0; i < 4; i++) {
+                colours[i] = (Colour_t)((data >> (2 * i)) & 0x03);
+            }
+        }
+
+        Colour_t m_background[4];
+        Colour_t m_sprites[2][4];
+};
@@ -7,6 +7,21 @@
 #include "tile.h"
 
 
+// OAM attribute flags (byte 3)
+const uint8_t SPRITE_PRIORITY = 0x80;
+const uint8_t SPRITE_Y_FLIP = 0x40;
+const uint8_t SPRITE_X_FLIP = 0x20;
+const uint8_t SPRITE_PALETTE = 0x10;
+
+// One OAM entry, in the same byte order as OAM so it can be copied directly
+typedef struct SpriteAttributes {
+    uint8_t y;
+    uint8_t x;
+    uint8_t tile;
+    uint8_t flags;
+} SpriteAttributes_t;
+
+
 class Sprite {
     public:
         Sprite(int, MemoryMap &);
@@ -5,14 +5,16 @@ Tile::Tile(uint16_t starting_address, MemoryMap &mem_map) {
     // Initialize all pixels as colour 0, normally white
     this->init_tile();
 
-    int buffer_index = 0;
-    for (int i = 0; i < 2 * TILE_HEIGHT; i += 2) {
-        TileRow row(starting_address + i, mem_map);
-
-        for (int x = 0; x < TILE_WIDTH; x++) {
-            m_buffer[buffer_index] = row.get_pixel(x);
-            buffer_index++;
-        }
+    uint8_t tile_data[TILE_BYTE_LENGTH];
+    for (int i = 0; i < TILE_BYTE_LENGTH; i++) {
+        tile_data[i] = mem_map.read(starting_address + i);
+    }
+
+    uint8_t pixels[TILE_WIDTH * TILE_HEIGHT];
+    decode_tile_rows(tile_data, pixels, TILE_HEIGHT);
+
+    for (int i = 0; i < TILE_WIDTH * TILE_HEIGHT; i++) {
+        m_buffer[i] = (PixelColour_t)pixels[i];
     }
 }
 
@@ -6,6 +6,7 @@
 
 #include "../memory/memory_map.h"
 #include "definitions.h"
+#include "tile_decoder.h"
 
 
 class Tile {
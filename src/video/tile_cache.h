@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "definitions.h"
+#include "tile_decoder.h"
+
+
+// Tile data at 0x8000-0x97FF holds 384 tiles
+const int NUM_TILES = 384;
+const int TILE_DATA_BYTES = NUM_TILES * TILE_BYTE_LENGTH;
+
+
+// Every tile in VRAM decoded to one colour index per byte. MemoryMap keeps it
+// up to date on VRAM writes so the renderer can copy whole rows of 8 pixels.
+class TileCache {
+    public:
+        TileCache() {
+            std::memset(m_pixels, 0, sizeof(m_pixels));
+        }
+
+        // Decode the row containing the tile data byte at offset from 0x8000
+        void update(uint16_t offset, const uint8_t *tile_data) {
+            if (offset >= TILE_DATA_BYTES) {
+                return;
+            }
+
+            offset &= ~0x1;
+            decode_tile_rows(tile_data + offset, m_pixels[offset / TILE_BYTE_LENGTH][(offset % TILE_BYTE_LENGTH) / 2], 1);
+        }
+
+        // Tile data and decoded rows are both contiguous, so every tile decodes in one pass
+        void rebuild(const uint8_t *tile_data) {
+            decode_tile_rows(tile_data, &m_pixels[0][0][0], NUM_TILES * TILE_HEIGHT);
+        }
+
+        // 8 colour indices, left to right
+        const uint8_t *get_row(int tile, int row) const {
+            return m_pixels[tile][row];
+        }
+
+    private:
+        uint8_t m_pixels[NUM_TILES][TILE_HEIGHT][TILE_WIDTH];
+};
@@ -0,0 +1,169 @@
+#include "tile_decoder.h"
+
+#ifdef TILE_DECODER_X86
+#include <immintrin.h>
+#endif
+
+
+// Byte x of s_spread_bits[b] holds bit 7 - x of b, so a row is spread[lsb] | spread[msb] << 1
+static uint64_t s_spread_bits[256];
+
+static bool init_spread_bits() {
+    for (int value = 0; value < 256; value++) {
+        uint8_t bytes[TILE_WIDTH];
+        for (int x = 0; x < TILE_WIDTH; x++) {
+            bytes[x] = (value >> (7 - x)) & 0x1;
+        }
+        std::memcpy(&s_spread_bits[value], bytes, sizeof(bytes));
+    }
+
+    return true;
+}
+
+static const bool s_spread_bits_ready = init_spread_bits();
+
+
+void decode_tile_rows_portable(const uint8_t *tile_data, uint8_t *pixels, int rows) {
+    for (int row = 0; row < rows; row++) {
+        // Each byte is 0 or 1, so shifting the whole word keeps every bit inside its byte
+        uint64_t row_pixels = s_spread_bits[tile_data[2 * row]] | (s_spread_bits[tile_data[2 * row + 1]] << 1);
+        std::memcpy(pixels + row * TILE_WIDTH, &row_pixels, TILE_WIDTH);
+    }
+}
+
+
+#ifdef TILE_DECODER_X86
+bool cpu_supports_sse2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+}
+
+bool cpu_supports_avx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+// Input bytes are L0 M0 L1 M1 ... Unpacking a register with itself three times
+// turns each row into 8 copies of L followed by 8 copies of M. Gathering the
+// L and M copies of two rows and testing each copy against its bit gives 0 or 1
+// per pixel and plane, the colour index is then low + 2 * high.
+__attribute__((target("sse2"), always_inline))
+static inline __m128i decode_row_pair_sse2(__m128i words, __m128i bit_mask, __m128i ones) {
+    __m128i row_0 = _mm_unpacklo_epi32(words, words);
+    __m128i row_1 = _mm_unpackhi_epi32(words, words);
+
+    __m128i low = _mm_min_epu8(_mm_and_si128(_mm_unpacklo_epi64(row_0, row_1), bit_mask), ones);
+    __m128i high = _mm_min_epu8(_mm_and_si128(_mm_unpackhi_epi64(row_0, row_1), bit_mask), ones);
+    return _mm_add_epi8(low, _mm_add_epi8(high, high));
+}
+
+__attribute__((target("sse2")))
+void decode_tile_rows_sse2(const uint8_t *tile_data, uint8_t *pixels, int rows) {
+    const __m128i bit_mask = _mm_set_epi8(1, 2, 4, 8, 16, 32, 64, (char)128, 1, 2, 4, 8, 16, 32, 64, (char)128);
+    const __m128i ones = _mm_set1_epi8(1);
+
+    int row = 0;
+    for (; row + TILE_HEIGHT <= rows; row += TILE_HEIGHT) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(tile_data + 2 * row));
+
+        __m128i bytes_0 = _mm_unpacklo_epi8(data, data);
+        __m128i bytes_1 = _mm_unpackhi_epi8(data, data);
+        __m128i words_0 = _mm_unpacklo_epi16(bytes_0, bytes_0);
+        __m128i words_1 = _mm_unpackhi_epi16(bytes_0, bytes_0);
+        __m128i words_2 = _mm_unpacklo_epi16(bytes_1, bytes_1);
+        __m128i words_3 = _mm_unpackhi_epi16(bytes_1, bytes_1);
+
+        __m128i *output = reinterpret_cast<__m128i *>(pixels + row * TILE_WIDTH);
+        _mm_storeu_si128(output, decode_row_pair_sse2(words_0, bit_mask, ones));
+        _mm_storeu_si128(output + 1, decode_row_pair_sse2(words_1, bit_mask, ones));
+        _mm_storeu_si128(output + 2, decode_row_pair_sse2(words_2, bit_mask, ones));
+        _mm_storeu_si128(output + 3, decode_row_pair_sse2(words_3, bit_mask, ones));
+    }
+
+    decode_tile_rows_portable(tile_data + 2 * row, pixels + row * TILE_WIDTH, rows - row);
+}
+
+// Same steps as SSE2 on two tiles at once. Unpacks work within each 128 bit
+// lane, so the results are regrouped by lane before storing.
+__attribute__((target("avx2"), always_inline))
+static inline __m256i decode_row_pair_avx2(__m256i words, __m256i bit_mask, __m256i ones) {
+    __m256i row_0 = _mm256_unpacklo_epi32(words, words);
+    __m256i row_1 = _mm256_unpackhi_epi32(words, words);
+
+    __m256i low = _mm256_min_epu8(_mm256_and_si256(_mm256_unpacklo_epi64(row_0, row_1), bit_mask), ones);
+    __m256i high = _mm256_min_epu8(_mm256_and_si256(_mm256_unpackhi_epi64(row_0, row_1), bit_mask), ones);
+    return _mm256_add_epi8(low, _mm256_add_epi8(high, high));
+}
+
+__attribute__((target("avx2")))
+void decode_tile_rows_avx2(const uint8_t *tile_data, uint8_t *pixels, int rows) {
+    const __m256i bit_mask = _mm256_set_epi8(
+        1, 2, 4, 8, 16, 32, 64, (char)128, 1, 2, 4, 8, 16, 32, 64, (char)128,
+        1, 2, 4, 8, 16, 32, 64, (char)128, 1, 2, 4, 8, 16, 32, 64, (char)128);
+    const __m256i ones = _mm256_set1_epi8(1);
+
+    int row = 0;
+    for (; row + 2 * TILE_HEIGHT <= rows; row += 2 * TILE_HEIGHT) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(tile_data + 2 * row));
+
+        __m256i bytes_0 = _mm256_unpacklo_epi8(data, data);
+        __m256i bytes_1 = _mm256_unpackhi_epi8(data, data);
+        __m256i words_0 = _mm256_unpacklo_epi16(bytes_0, bytes_0);
+        __m256i words_1 = _mm256_unpackhi_epi16(bytes_0, bytes_0);
+        __m256i words_2 = _mm256_unpacklo_epi16(bytes_1, bytes_1);
+        __m256i words_3 = _mm256_unpackhi_epi16(bytes_1, bytes_1);
+
+        // Rows 0-1, 2-3, 4-5, 6-7 of the first tile in the low lanes, of the second tile in the high lanes
+        __m256i rows_01 = decode_row_pair_avx2(words_0, bit_mask, ones);
+        __m256i rows_23 = decode_row_pair_avx2(words_1, bit_mask, ones);
+        __m256i rows_45 = decode_row_pair_avx2(words_2, bit_mask, ones);
+        __m256i rows_67 = decode_row_pair_avx2(words_3, bit_mask, ones);
+
+        __m256i *output = reinterpret_cast<__m256i *>(pixels + row * TILE_WIDTH);
+        _mm256_storeu_si256(output, _mm256_permute2x128_si256(rows_01, rows_23, 0x20));
+        _mm256_storeu_si256(output + 1, _mm256_permute2x128_si256(rows_45, rows_67, 0x20));
+        _mm256_storeu_si256(output + 2, _mm256_permute2x128_si256(rows_01, rows_23, 0x31));
+        _mm256_storeu_si256(output + 3, _mm256_permute2x128_si256(rows_45, rows_67, 0x31));
+    }
+
+    decode_tile_rows_portable(tile_data + 2 * row, pixels + row * TILE_WIDTH, rows - row);
+}
+#endif
+
+
+static TileDecoder_t select_tile_decoder() {
+#ifdef TILE_DECODER_X86
+    if (cpu_supports_avx2()) {
+        return decode_tile_rows_avx2;
+    }
+    if (cpu_supports_sse2()) {
+        return decode_tile_rows_sse2;
+    }
+#endif
+    return decode_tile_rows_portable;
+}
+
+static const TileDecoder_t s_tile_decoder = select_tile_decoder();
+
+
+void decode_tile_rows(const uint8_t *tile_data, uint8_t *pixels, int rows) {
+    // Single rows come from VRAM writes, the vector versions only pay off for whole tiles
+    if (rows < TILE_HEIGHT) {
+        decode_tile_rows_portable(tile_data, pixels, rows);
+        return;
+    }
+
+    s_tile_decoder(tile_data, pixels, rows);
+}
+
+const char *get_tile_decoder_name() {
+#ifdef TILE_DECODER_X86
+    if (s_tile_decoder == decode_tile_rows_avx2) {
+        return "AVX2";
+    }
+    if (s_tile_decoder == decode_tile_rows_sse2) {
+        return "SSE2";
+    }
+#endif
+    return "portable";
+}
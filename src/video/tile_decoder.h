@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "definitions.h"
+
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TILE_DECODER_X86
+#endif
+
+
+// Decodes rows of 2bpp tile data, 2 bytes per row (low bits then high bits),
+// into one colour index per byte, 8 bytes per row
+typedef void (*TileDecoder_t)(const uint8_t *, uint8_t *, int);
+
+
+// Decode with the fastest implementation supported by the host CPU
+void decode_tile_rows(const uint8_t *, uint8_t *, int);
+const char *get_tile_decoder_name();
+
+// Portable lookup table version, also used for the rows left over by the vector versions
+void decode_tile_rows_portable(const uint8_t *, uint8_t *, int);
+
+#ifdef TILE_DECODER_X86
+bool cpu_supports_sse2();
+bool cpu_supports_avx2();
+
+// 8 rows (one tile) per iteration
+void decode_tile_rows_sse2(const uint8_t *, uint8_t *, int);
+// 16 rows (two tiles) per iteration
+void decode_tile_rows_avx2(const uint8_t *, uint8_t *, int);
+#endif
@@ -5,97 +5,171 @@ Video::Video(MemoryMap &mem_map, UI &ui, bool headless):
 m_memory_map(mem_map),
 m_ui(ui),
 m_cycle_counter(0),
-m_buffer(MAP_SIZE, MAP_SIZE),
-m_headless(headless)
+m_scheduler(nullptr),
+m_last_sync(0),
+m_buffer(LCD_WIDTH, LCD_HEIGHT),
+m_headless(headless),
+m_frame_count(0),
+m_num_line_sprites(0),
+m_scanned_line(-1)
 {
     m_current_video_mode = this->get_video_mode();
+    m_mode_clocks = this->get_mode_clocks(m_current_video_mode);
+
+    m_memory_map.set_io_listener(STAT, this);
+    m_memory_map.set_io_listener(LY, this);
+    m_memory_map.set_io_listener(LYC, this);
 }
 
 Video::~Video() {
-
+    m_memory_map.set_io_listener(STAT, nullptr);
+    m_memory_map.set_io_listener(LY, nullptr);
+    m_memory_map.set_io_listener(LYC, nullptr);
 }
 
 void Video::tick(int cycles) {
-    if (m_headless) return;
-
     m_cycle_counter += cycles;
 
-    if (m_current_video_mode != this->get_video_mode()) {
-        VideoMode_t video_mode = this->get_video_mode();
-        std::cout << "video mode changed" << std::endl;
-        this->set_video_mode(video_mode);
+    // Nothing changes until the current mode has run for m_mode_clocks
+    if (m_cycle_counter <= m_mode_clocks) {
+        return;
     }
 
-    if (this->get_line() == this->get_line_compare()) {
-        this->set_coincidence_flag(true);
-    }
-    else {
-        this->set_coincidence_flag(false);
-    }
+    m_cycle_counter = m_cycle_counter % m_mode_clocks;
 
     switch (m_current_video_mode) {
         case HBLANK_Mode:
-            if (m_cycle_counter > HBLANK_CLOCKS) {
-                m_cycle_counter = m_cycle_counter % HBLANK_CLOCKS;
-
-                this->write_scanline(this->get_line());
-                log_video("Scanlines drawn: %d", this->get_line());
-                this->increment_line();
-
-                if (this->get_line() == 144) {
-                    log_video("Switching to V-Blank mode");
-                    
-                    this->set_video_mode(VBLANK_Mode);
-                } else {
-                    log_video("Switching to OAM mode");
-                    
-                    this->set_video_mode(OAM_Mode);
-                }
+            this->write_scanline(this->get_line());
+            log_video("Scanlines drawn: %d", this->get_line());
+            this->increment_line();
+
+            if (this->get_line() == 144) {
+                log_video("Switching to V-Blank mode");
+                
+                this->set_video_mode(VBLANK_Mode);
+            } else {
+                log_video("Switching to OAM mode");
+                
+                this->set_video_mode(OAM_Mode);
             }
             break;
         case VBLANK_Mode:
-            if (m_cycle_counter > VBLANK_SCANLINE_CLOCKS) {
-                m_cycle_counter = m_cycle_counter % VBLANK_SCANLINE_CLOCKS;
+            this->increment_line();
 
-                this->increment_line();
+            if (this->get_line() == 154) {
+                // The finished frame stays in the buffer until line 0 is drawn again
+                if (this->lcd_display_enabled()) {
+                    m_buffer.update_rgba();
 
-                if (this->get_line() == 154) {
-                    if (this->lcd_display_enabled()) {
-                        this->draw_sprites();
+                    // Headless runs keep rendering into the buffer with no UI attached
+                    if (!m_headless) {
                         this->draw();
-
-                        this->notify();
                     }
 
-                    this->reset_line();
+                    this->notify();
+                }
+                else {
                     m_buffer.reset();
-
-                    log_video("Switching to OAM mode");
-                    
-                    this->set_video_mode(OAM_Mode);
                 }
-            }
-            break;
-        case OAM_Mode:
-            if (m_cycle_counter > OAM_CLOCKS) {
-                m_cycle_counter = m_cycle_counter % OAM_CLOCKS;
 
-                log_video("Switching to Data Transfer mode");
+                m_frame_count++;
+                this->reset_line();
+
+                log_video("Switching to OAM mode");
                 
-                this->set_video_mode(Data_Transfer_Mode);
+                this->set_video_mode(OAM_Mode);
             }
             break;
+        case OAM_Mode:
+            log_video("Switching to Data Transfer mode");
+            
+            this->set_video_mode(Data_Transfer_Mode);
+            break;
         case Data_Transfer_Mode:
-            if (m_cycle_counter > DATA_TRANSFER_CLOCKS) {
-                m_cycle_counter = m_cycle_counter % DATA_TRANSFER_CLOCKS;
+            this->trigger_coincidence_interrupt();
 
-                this->trigger_coincidence_interrupt();
+            log_video("Switching to H-Blank mode");
+            
+            this->set_video_mode(HBLANK_Mode);
+            break;
+    }
+}
 
-                log_video("Switching to H-Blank mode");
-                
-                this->set_video_mode(HBLANK_Mode);
+void Video::set_scheduler(Scheduler *scheduler) {
+    m_scheduler = scheduler;
+    m_last_sync = scheduler->get_cycles();
+
+    m_scheduler->set_handler(EVENT_VIDEO, this);
+    this->schedule_next_event();
+}
+
+void Video::handle_event(EventType_t, uint64_t cycles) {
+    int elapsed = (int)(cycles - m_last_sync);
+    m_last_sync = cycles;
+
+    this->tick(elapsed);
+    this->schedule_next_event();
+}
+
+// Count the cycles since the last event, used before changing the mode between events
+void Video::catch_up() {
+    if (m_scheduler == nullptr) {
+        return;
+    }
+
+    m_cycle_counter += (int)(m_scheduler->get_cycles() - m_last_sync);
+    m_last_sync = m_scheduler->get_cycles();
+}
+
+// The mode ends on the first cycle past m_mode_clocks, matching tick
+void Video::schedule_next_event() {
+    if (m_scheduler == nullptr) {
+        return;
+    }
+
+    int remaining = std::max(m_mode_clocks + 1 - m_cycle_counter, 0);
+    m_scheduler->schedule(EVENT_VIDEO, m_last_sync + remaining);
+}
+
+void Video::save_state(StateWriter &writer) const {
+    writer.write<int32_t>(m_cycle_counter);
+    writer.write<int32_t>(m_mode_clocks);
+    writer.write(m_last_sync);
+    writer.write(m_frame_count);
+    writer.write<uint8_t>(m_current_video_mode);
+    writer.write_bytes(m_buffer.get_row(0), LCD_WIDTH * LCD_HEIGHT);
+}
+
+void Video::load_state(StateReader &reader) {
+    m_cycle_counter = reader.read<int32_t>();
+    m_mode_clocks = reader.read<int32_t>();
+    reader.read(m_last_sync);
+    reader.read(m_frame_count);
+    m_current_video_mode = (VideoMode_t)reader.read<uint8_t>();
+    reader.read_bytes(m_buffer.get_row(0), LCD_WIDTH * LCD_HEIGHT);
+    m_buffer.update_rgba();
+
+    m_num_line_sprites = 0;
+    m_scanned_line = -1;
+
+    this->schedule_next_event();
+}
+
+void Video::io_written(IORegisters_t reg, uint8_t data) {
+    switch (reg) {
+        case STAT:
+            // Writing different mode bits moves the PPU to that mode
+            if ((VideoMode_t)(data & 0x03) != m_current_video_mode) {
+                this->catch_up();
+                this->set_video_mode((VideoMode_t)(data & 0x03));
             }
             break;
+        case LY:
+        case LYC:
+            this->update_coincidence_flag();
+            break;
+        default:
+            break;
     }
 }
 
@@ -188,7 +262,13 @@ void Video::set_video_mode(VideoMode_t video_mode) {
     stat |= video_mode;
 
     m_current_video_mode = video_mode;
+    m_mode_clocks = this->get_mode_clocks(video_mode);
     this->write_io_register(STAT, stat);
+    this->schedule_next_event();
+
+    if (video_mode == OAM_Mode) {
+        this->scan_oam(this->get_line());
+    }
 
     bool vblank_interrupt_set = false;
     bool lcdc_stat_interrupt_set = false;
@@ -241,6 +321,14 @@ void Video::set_coincidence_flag(bool set) {
     this->write_io_register(STAT, stat);
 }
 
+void Video::update_coincidence_flag() {
+    bool coincidence = (this->get_line() == this->get_line_compare());
+
+    if (coincidence != this->get_coincidence_flag()) {
+        this->set_coincidence_flag(coincidence);
+    }
+}
+
 bool Video::coincidence_interrupt_enabled() {
     // Check bit 6 of the LCDC STAT register
     uint8_t stat = this->read_io_register(STAT);
@@ -292,36 +380,23 @@ int Video::get_window_x() {
 
 /******   Palette   ******/
 Palette Video::get_background_palette() {
-    Palette palette;
-    uint8_t bgp = this->read_io_register(BGP);
-
-    palette.colour0 = (Colour_t)(bgp & 0x03);
-    palette.colour1 = (Colour_t)((bgp >> 2) & 0x03);
-    palette.colour2 = (Colour_t)((bgp >> 4) & 0x03);
-    palette.colour3 = (Colour_t)((bgp >> 6) & 0x03);
+    const Colour_t *colours = m_memory_map.get_palette_cache().get_background();
 
+    Palette palette = {colours[Colour0], colours[Colour1], colours[Colour2], colours[Colour3]};
     return palette;
 }
 
 Palette Video::get_sprite_palette_0() {
-    Palette palette;
-    uint8_t obp0 = this->read_io_register(OBP0);
-
-    palette.colour1 = (Colour_t)((obp0 >> 2) & 0x03);
-    palette.colour2 = (Colour_t)((obp0 >> 4) & 0x03);
-    palette.colour3 = (Colour_t)((obp0 >> 6) & 0x03);
+    const Colour_t *colours = m_memory_map.get_palette_cache().get_sprite(OBJECT_PALETTE_0);
 
+    Palette palette = {colours[Colour0], colours[Colour1], colours[Colour2], colours[Colour3]};
     return palette;
 }
 
 Palette Video::get_sprite_palette_1() {
-    Palette palette;
-    uint8_t obp1 = this->read_io_register(OBP1);
-
-    palette.colour1 = (Colour_t)((obp1 >> 2) & 0x03);
-    palette.colour2 = (Colour_t)((obp1 >> 4) & 0x03);
-    palette.colour3 = (Colour_t)((obp1 >> 6) & 0x03);
+    const Colour_t *colours = m_memory_map.get_palette_cache().get_sprite(OBJECT_PALETTE_1);
 
+    Palette palette = {colours[Colour0], colours[Colour1], colours[Colour2], colours[Colour3]};
     return palette;
 }
 
@@ -331,9 +406,12 @@ void Video::draw() {
 }
 
 void Video::write_scanline(uint8_t line) {
-    if (!this->lcd_display_enabled()) return;
+    if (!this->lcd_display_enabled() || line >= LCD_HEIGHT) return;
     log_video("LCD enabled");    
 
+    std::memset(m_line_bg_index, 0, sizeof(m_line_bg_index));
+    std::memset(m_buffer.get_row(line), WHITE, LCD_WIDTH);
+
     if (this->background_display_enabled()) {
         log_video("Drawing background scanline: %d", line);
         
@@ -345,183 +423,152 @@ void Video::write_scanline(uint8_t line) {
         
         this->draw_window_line(line);
     }
+
+    this->draw_sprite_line(line);
 }
 
 void Video::draw_background_line(uint8_t line) {
-    Palette palette = this->get_background_palette();
-    TileDataTableSelect_t tile_data_set = this->get_tile_data_selected();
-    TileMapTableSelect_t tile_map_address = this->get_background_tile_map_selected();
-
-    unsigned int scroll_x = this->get_scroll_x();
-    unsigned int scroll_y = this->get_scroll_y();
-
-    unsigned int y = line;
+    const Colour_t *colours = m_memory_map.get_palette_cache().get_background();
 
-    for (unsigned int x = 0; x < LCD_WIDTH; x++) {
-        // Add scroll to current coordinates
-        unsigned int sc_x = x + scroll_x;
-        unsigned int sc_y = y + scroll_y;
+    // Background wraps around
+    unsigned int map_x = this->get_scroll_x();
+    unsigned int map_y = (line + this->get_scroll_y()) % MAP_SIZE;
 
-        // Background wraps around
-        unsigned int bg_x = sc_x % MAP_SIZE;
-        unsigned int bg_y = sc_y % MAP_SIZE;
-
-        // Get tile index
-        unsigned int tile_x = bg_x / TILE_WIDTH;
-        unsigned int tile_y = bg_y / TILE_HEIGHT;
-
-        unsigned int tile_pixel_x = bg_x % TILE_WIDTH;
-        unsigned int tile_pixel_y = bg_y % TILE_HEIGHT;
+    this->draw_tile_map_line(line, this->get_background_tile_map_selected(), map_x, map_y, 0, colours);
+}
 
-        // Get tile from tile data
-        unsigned int tile_index = tile_y * TILES_PER_LINE + tile_x;
-        uint16_t tile_id_address = (uint16_t)tile_map_address + tile_index;
-        uint8_t tile_id = m_memory_map.read(tile_id_address);
+void Video::draw_window_line(uint8_t line) {
+    const Colour_t *colours = m_memory_map.get_palette_cache().get_background();
 
-        // Depending on the selected Tile Data Set, index is either signed or unsigned
-        unsigned int tile_offset;
-        if (tile_data_set == TILE_DATA_UNSIGNED) {
-            tile_offset = tile_id * TILE_BYTE_LENGTH;
-        }
-        else if (tile_data_set == TILE_DATA_SIGNED) {
-            tile_offset = (static_cast<int8_t>(tile_id) + 128) * TILE_BYTE_LENGTH;
-        }
+    // Window is drawn from (WX - 7, WY) to the bottom right of the screen
+    int window_x = this->get_window_x() - 7;
+    int window_y = this->get_window_y();
 
-        uint16_t tile_address = (uint16_t)tile_data_set + tile_offset + (tile_pixel_y * 2);
+    if (line < window_y || window_x >= LCD_WIDTH) {
+        return;
+    }
 
-        TileRow row(tile_address, m_memory_map);
+    int start_x = std::max(window_x, 0);
 
-        PixelColour_t pixel = row.get_pixel(tile_pixel_x);
-        Colour_t real_pixel = this->get_real_colour(pixel, palette);
-        m_buffer.set_pixel(x, y, real_pixel);
-    }
+    this->draw_tile_map_line(line, this->get_window_tile_map_selected(), start_x - window_x, line - window_y, start_x, colours);
 }
 
-void Video::draw_window_line(uint8_t line) {
-    Palette palette = this->get_background_palette();
+// Copy pixels of a tile map row into the scanline from start_x to the end of the line,
+// one decoded tile row at a time
+void Video::draw_tile_map_line(uint8_t line, TileMapTableSelect_t tile_map_address, unsigned int map_x, unsigned int map_y, int start_x, const Colour_t *colours) {
     TileDataTableSelect_t tile_data_set = this->get_tile_data_selected();
-    TileMapTableSelect_t tile_map_address = this->get_window_tile_map_selected();
+    const TileCache &tile_cache = m_memory_map.get_tile_cache();
 
-    unsigned int scroll_x = this->get_window_x() - 7;
-    unsigned int scroll_y = this->get_window_y();
+    unsigned int tile_y = (map_y / TILE_HEIGHT) % TILES_PER_LINE;
+    unsigned int tile_pixel_y = map_y % TILE_HEIGHT;
 
-    unsigned int y = line;
+    uint8_t *pixels = m_buffer.get_row(line);
 
-    for (unsigned int x = 0; x < LCD_WIDTH; x++) {
-        // Add scroll to current coordinates
-        unsigned int sc_x = x + scroll_x;
-        unsigned int sc_y = y - scroll_y;
-
-        // Get tile index
-        unsigned int tile_x = sc_x / TILE_WIDTH;
-        unsigned int tile_y = sc_y / TILE_HEIGHT;
-
-        unsigned int tile_pixel_x = sc_x % TILE_WIDTH;
-        unsigned int tile_pixel_y = sc_y % TILE_HEIGHT;
+    int x = start_x;
+    while (x < LCD_WIDTH) {
+        unsigned int tile_x = (map_x / TILE_WIDTH) % TILES_PER_LINE;
+        unsigned int tile_pixel_x = map_x % TILE_WIDTH;
 
         // Get tile from tile data
-        unsigned int tile_index = tile_y * TILES_PER_LINE + tile_x;
-        uint16_t tile_id_address = (uint16_t)tile_map_address + tile_index;
+        uint16_t tile_id_address = (uint16_t)tile_map_address + tile_y * TILES_PER_LINE + tile_x;
         uint8_t tile_id = m_memory_map.read(tile_id_address);
 
-        // Depending on the selected Tile Data Set, index is either signed or unsigned
-        unsigned int tile_offset;
-        if (tile_data_set == TILE_DATA_UNSIGNED) {
-            tile_offset = tile_id * TILE_BYTE_LENGTH;
-        }
-        else if (tile_data_set == TILE_DATA_SIGNED) {
-            tile_offset = (static_cast<int8_t>(tile_id) + 128) * TILE_BYTE_LENGTH;
-        }
+        // Depending on the selected Tile Data Set, index is either signed from tile 256 or unsigned from tile 0
+        int tile = (tile_data_set == TILE_DATA_UNSIGNED) ? tile_id : 256 + static_cast<int8_t>(tile_id);
+        const uint8_t *row = tile_cache.get_row(tile, tile_pixel_y);
 
-        uint16_t tile_address = (uint16_t)tile_data_set + tile_offset + (tile_pixel_y * 2);
-
-        TileRow row(tile_address, m_memory_map);
-
-        PixelColour_t pixel = row.get_pixel(tile_pixel_x);
-        Colour_t real_pixel = this->get_real_colour(pixel, palette);
-        m_buffer.set_pixel(x, y, real_pixel);
-    }    
-}
-
-void Video::draw_sprites() {
-    if (!sprite_display_enabled()) {
-        return;
-    }
-    
-    
-    log_video("Draw sprites");
-    
+        int count = std::min(TILE_WIDTH - (int)tile_pixel_x, LCD_WIDTH - x);
+        for (int i = 0; i < count; i++) {
+            uint8_t colour = row[tile_pixel_x + i];
+            m_line_bg_index[x + i] = colour;
+            pixels[x + i] = colours[colour];
+        }
 
-    for (int i = 0; i < NUM_SPRITES; i++) {
-        this->draw_sprite(i);
+        x += count;
+        map_x += count;
     }
 }
 
-void Video::draw_sprite(int sprite_num) {
-    Sprite sprite(sprite_num, m_memory_map);
+// OAM search, copy OAM once and keep the first 10 sprites overlapping the line
+void Video::scan_oam(uint8_t line) {
+    SpriteAttributes_t oam[NUM_SPRITES];
+    std::memcpy(oam, m_memory_map.get_oam(), sizeof(oam));
 
-    int sprite_x = (int)sprite.get_x_pos() - 8;
-    int sprite_y = (int)sprite.get_y_pos() - 16;
+    int height = (this->get_sprite_size() == SPRITEx16) ? 2 * TILE_HEIGHT : TILE_HEIGHT;
 
-    bool flip_x = sprite.get_x_flip();
-    bool flip_y = sprite.get_y_flip();
+    m_num_line_sprites = 0;
+    for (int i = 0; i < NUM_SPRITES && m_num_line_sprites < MAX_SPRITES_PER_LINE; i++) {
+        int top = (int)oam[i].y - 16;
+        if (line >= top && line < top + height) {
+            m_line_sprites[m_num_line_sprites] = oam[i];
+            m_num_line_sprites++;
+        }
+    }
 
-    bool priority = sprite.get_priority();
+    // The sprite with the lower x is drawn on top, ties go to the earlier OAM entry
+    std::stable_sort(m_line_sprites, m_line_sprites + m_num_line_sprites, [](const SpriteAttributes_t &a, const SpriteAttributes_t &b) {
+        return a.x < b.x;
+    });
 
-    if (sprite_x < 0|| sprite_x > LCD_WIDTH) {
+    m_scanned_line = line;
+}
+
+void Video::draw_sprite_line(uint8_t line) {
+    if (!this->sprite_display_enabled()) {
         return;
     }
 
-    if (sprite_y < 0 || sprite_y > LCD_HEIGHT) {
-        return;
+    // Use the scan from the start of the line, or scan now if the line is drawn outside of tick
+    if (m_scanned_line != line) {
+        this->scan_oam(line);
     }
+    m_scanned_line = -1;
 
-    
-    log_video("Drawing Sprite: %d", sprite_num);
-    log_video("  (%d, %d)", sprite_x, sprite_y);
-    log_video("  Flip X: %d", flip_x);
-    log_video("  Flip Y: %d", flip_y);
-    log_video("  Priority: %d", priority);
-    
+    const TileCache &tile_cache = m_memory_map.get_tile_cache();
+    int height = (this->get_sprite_size() == SPRITEx16) ? 2 * TILE_HEIGHT : TILE_HEIGHT;
 
-    ObjectPalette_t palette_select = sprite.get_palette();
-    Palette palette;
-    if (palette_select == OBJECT_PALETTE_0) {
-        palette = this->get_sprite_palette_0();
-    }
-    else if (palette_select == OBJECT_PALETTE_1) {
-        palette = this->get_sprite_palette_1();
-    }
+    const PaletteCache &palettes = m_memory_map.get_palette_cache();
 
-    Tile tile = sprite.get_tile();
+    uint8_t *line_pixels = m_buffer.get_row(line);
 
-    for (unsigned int y = 0; y < TILE_HEIGHT; y++) {
-        for (unsigned int x = 0; x < TILE_WIDTH; x++) {
-            int screen_x = sprite_x;
-            int screen_y = sprite_y;
+    // Once a sprite has an opaque pixel at x, sprites behind it are not drawn there
+    bool sprite_drawn[LCD_WIDTH] = {};
 
-            screen_x += (!flip_x) ? x : TILE_WIDTH - x - 1;
-            screen_y += (!flip_y) ? y : TILE_HEIGHT - y - 1;
+    for (int i = 0; i < m_num_line_sprites; i++) {
+        const SpriteAttributes_t &sprite = m_line_sprites[i];
 
-            PixelColour_t pixel = tile.get_pixel(x, y);
+        int row = line - ((int)sprite.y - 16);
+        if (sprite.flags & SPRITE_Y_FLIP) {
+            row = height - 1 - row;
+        }
+
+        // 8x16 sprites use an even/odd pair of tiles
+        int tile = (height == TILE_HEIGHT) ? sprite.tile : (sprite.tile & 0xFE) + row / TILE_HEIGHT;
+        const uint8_t *pixels = tile_cache.get_row(tile, row % TILE_HEIGHT);
+        const Colour_t *palette = palettes.get_sprite((sprite.flags & SPRITE_PALETTE) ? OBJECT_PALETTE_1 : OBJECT_PALETTE_0);
+        bool flip_x = (sprite.flags & SPRITE_X_FLIP) != 0;
+        bool behind_background = (sprite.flags & SPRITE_PRIORITY) != 0;
+
+        int sprite_x = (int)sprite.x - 8;
+        for (int x = 0; x < TILE_WIDTH; x++) {
+            int screen_x = sprite_x + x;
+            if (screen_x < 0 || screen_x >= LCD_WIDTH || sprite_drawn[screen_x]) {
+                continue;
+            }
 
             // Colour0 is transparent for sprites, do not draw
-            if (pixel == Colour0) {
+            uint8_t colour = pixels[flip_x ? TILE_WIDTH - 1 - x : x];
+            if (colour == Colour0) {
                 continue;
             }
+            sprite_drawn[screen_x] = true;
 
             // If sprite priority is set, only draw over background colour 0
-            if (priority) {
-                Colour_t bg_pixel = m_buffer.get_pixel(screen_x, screen_y);
-                PixelColour_t colour_num = this->get_pixel_colour_from_real_colour(bg_pixel, this->get_background_palette());
-
-                if (colour_num != Colour0) {
-                    continue;
-                }
+            if (behind_background && m_line_bg_index[screen_x] != Colour0) {
+                continue;
             }
 
-            Colour_t real_pixel = this->get_real_colour(pixel, palette);
-            m_buffer.set_pixel(screen_x, screen_y, real_pixel);
+            line_pixels[screen_x] = palette[colour];
         }
     }
 }
@@ -540,25 +587,6 @@ Colour_t Video::get_real_colour(PixelColour_t colour, Palette palette) {
     }
 }
 
-PixelColour_t Video::get_pixel_colour_from_real_colour(Colour_t colour, Palette palette) {
-    if (palette.colour0 == colour) {
-        return Colour0;
-    }
-
-    if (palette.colour1 == colour) {
-        return Colour1;
-    }
-
-    if (palette.colour2 == colour) {
-        return Colour2;
-    }
-
-    if (palette.colour3 == colour) {
-        return Colour3;
-    }
-}
-
-
 uint8_t Video::read_io_register(IORegisters_t reg) {
     return this->m_memory_map.read(reg);
 }
@@ -581,6 +609,21 @@ void Video::trigger_coincidence_interrupt() {
 
 void Video::increment_line() {
     this->m_memory_map.increment_io_counter(LY);
+    this->update_coincidence_flag();
+}
+
+int Video::get_mode_clocks(VideoMode_t video_mode) {
+    switch (video_mode) {
+        case HBLANK_Mode:
+            return HBLANK_CLOCKS;
+        case VBLANK_Mode:
+            return VBLANK_SCANLINE_CLOCKS;
+        case OAM_Mode:
+            return OAM_CLOCKS;
+        case Data_Transfer_Mode:
+        default:
+            return DATA_TRANSFER_CLOCKS;
+    }
 }
 
 void Video::reset_line() {
@@ -590,3 +633,7 @@ void Video::reset_line() {
 FrameBuffer &Video::get_buffer() {
     return m_buffer;
 }
+
+uint64_t Video::get_frame_count() const {
+    return m_frame_count;
+}
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <algorithm>
+
 #include "../memory/memory_map.h"
+#include "../scheduler/scheduler.h"
 #include "../user_interface/user_interface_sfml.h"
 #include "../debugger/logger.h"
 #include "definitions.h"
 #include "tile.h"
+#include "tile_cache.h"
 #include "sprite.h"
 #include "framebuffer.h"
 #include "video_subject.h"
@@ -15,13 +19,20 @@
 #endif
 
 
-class Video : public VideoSubject {
+class Video : public VideoSubject, public IOListener, public EventHandler {
     public:
         Video(MemoryMap &, UI &, bool=false);
         virtual ~Video();
 
         void tick(int);
 
+        // Run from the scheduler instead of tick, mode changes become EVENT_VIDEO deadlines
+        void set_scheduler(Scheduler *);
+        void handle_event(EventType_t, uint64_t) override;
+
+        // Keeps the mode and LY=LYC flag in sync with writes to STAT, LY and LYC
+        void io_written(IORegisters_t, uint8_t) override;
+
         // LCDC Register
         bool lcd_display_enabled();
         void set_lcd_display_enabled(bool);
@@ -38,6 +49,7 @@ class Video : public VideoSubject {
         void set_video_mode(VideoMode_t);
         bool get_coincidence_flag();
         void set_coincidence_flag(bool);
+        void update_coincidence_flag();
         bool coincidence_interrupt_enabled();
         bool oam_interrupt_enabled();
         bool vblank_interrupt_enabled();
@@ -61,30 +73,56 @@ class Video : public VideoSubject {
         void write_scanline(uint8_t);
         void draw_background_line(uint8_t);
         void draw_window_line(uint8_t);
-        void draw_sprites();
-        void draw_sprite(int);
+        void scan_oam(uint8_t);
+        void draw_sprite_line(uint8_t);
 
         Colour_t get_real_colour(PixelColour_t, Palette);
-        PixelColour_t get_pixel_colour_from_real_colour(Colour_t, Palette);
 
         uint8_t read_io_register(IORegisters_t);
         void write_io_register(IORegisters_t, uint8_t);
 
         FrameBuffer &get_buffer();
+        // Frames completed since power on, including frames with the LCD off
+        uint64_t get_frame_count() const;
+
+        // Mode timing, frame count and the frame being drawn
+        void save_state(StateWriter &) const;
+        void load_state(StateReader &);
 
     private:
         MemoryMap &m_memory_map;
         UI &m_ui;
+        // Cycles spent in the current mode, the next mode starts once this passes m_mode_clocks
         int m_cycle_counter;
+        int m_mode_clocks;
+
+        Scheduler *m_scheduler;
+        // Master cycle count m_cycle_counter was last brought up to
+        uint64_t m_last_sync;
         int m_lines_drawn;
 
         bool m_headless;
+        uint64_t m_frame_count;
 
         VideoMode_t m_current_video_mode;
 
         FrameBuffer m_buffer;
 
+        // Background/window colour index of the line being drawn, for sprite priority
+        uint8_t m_line_bg_index[LCD_WIDTH];
+
+        // Sprites selected by the OAM scan for m_scanned_line, in drawing priority order
+        SpriteAttributes_t m_line_sprites[MAX_SPRITES_PER_LINE];
+        int m_num_line_sprites;
+        int m_scanned_line;
+
         void trigger_coincidence_interrupt();
         void increment_line();
         void reset_line();
+        static int get_mode_clocks(VideoMode_t);
+
+        void catch_up();
+        void schedule_next_event();
+
+        void draw_tile_map_line(uint8_t, TileMapTableSelect_t, unsigned int, unsigned int, int, const Colour_t *);
 };
\ No newline at end of file
@@ -902,6 +902,30 @@ TEST(CPU_ALU, INCHalfCarry) {
     EXPECT_EQ(true, cpu.read_flag_register(HALF_CARRY_FLAG));
 }
 
+TEST(CPU_ALU, INCKeepsCarryFromADD) {
+    MemoryMap mem_map;
+    
+    CPU cpu(mem_map);
+
+    cpu.write_register(REG_A, 0xF0);
+    cpu.write_register(REG_B, 0x20);
+    cpu.write_register(REG_C, 0x0F);
+
+    // ADD A, B sets the carry flag, INC C must keep it
+    cpu.decode_op(0x80);
+    cpu.decode_op(0x0C);
+
+    EXPECT_EQ(0x10, cpu.read_register(REG_A));
+    EXPECT_EQ(0x10, cpu.read_register(REG_C));
+
+    // Check Flag register
+    EXPECT_EQ(false, cpu.read_flag_register(ZERO_FLAG));
+    EXPECT_EQ(false, cpu.read_flag_register(SUBTRACT_FLAG));
+    EXPECT_EQ(true, cpu.read_flag_register(HALF_CARRY_FLAG));
+    EXPECT_EQ(true, cpu.read_flag_register(CARRY_FLAG));
+    EXPECT_EQ(0x30, cpu.read_register(REG_F));
+}
+
 TEST(CPU_ALU, INC_HL) {
     uint8_t opcode = 0x34;
     uint16_t address = 0xFF80;
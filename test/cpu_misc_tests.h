@@ -174,6 +174,60 @@ TEST(CPU_MISC, HALT) {
     EXPECT_TRUE(cpu.is_running());
 }
 
+// Skip HALT and a polling loop until they can change
+TEST(CPU_MISC, FastForward) {
+    uint16_t PC = 0xFF80;
+    uint16_t flag_address = 0xFF90;
+
+    MemoryMap mem_map;
+    CPU cpu(mem_map);
+
+    // LDH A, (0x90); CP 0x01; JR NZ, -6
+    uint8_t loop[] = {0xF0, 0x90, 0xFE, 0x01, 0x20, 0xFA};
+    for (unsigned int i = 0; i < sizeof(loop); i++) {
+        mem_map.write(PC + i, loop[i]);
+    }
+    mem_map.write(flag_address, 0x00);
+
+    cpu.write_register(REG_PC, PC);
+    cpu.decode_op(0xF3);
+
+    // Nothing to skip before the loop has jumped back once
+    EXPECT_EQ(0, cpu.fast_forward(1000));
+
+    EXPECT_EQ(12, cpu.tick());
+    EXPECT_EQ(8, cpu.tick());
+    EXPECT_EQ(12, cpu.tick());
+    EXPECT_EQ(PC, cpu.read_register(REG_PC));
+
+    uint64_t cycle_count = cpu.get_cycle_count();
+
+    // Whole 32 cycle passes before the deadline
+    EXPECT_EQ(992, cpu.fast_forward(1000));
+    EXPECT_EQ(cycle_count + 992, cpu.get_cycle_count());
+    EXPECT_EQ(PC, cpu.read_register(REG_PC));
+
+    // The next pass would exit the loop
+    mem_map.write(flag_address, 0x01);
+    EXPECT_EQ(0, cpu.fast_forward(1000));
+
+    // HALT runs up to the first 4 cycle tick that reaches the deadline
+    cpu.decode_op(0x76);
+    EXPECT_EQ(12, cpu.fast_forward(10));
+
+    // No deadline to wake up for, and never more than fits in one scheduler step
+    EXPECT_EQ(0, cpu.fast_forward(NO_EVENT));
+    EXPECT_EQ((uint64_t)INT_MAX / 4 * 4, cpu.fast_forward(NO_EVENT - 1));
+
+    // A pending interrupt ends HALT even with interrupts disabled
+    cpu.set_interrupt_enable_bit(TIMER, true);
+    cpu.set_interrupt_flag_bit(TIMER, true);
+    EXPECT_EQ(0, cpu.fast_forward(10));
+
+    cpu.tick();
+    EXPECT_TRUE(cpu.is_running());
+}
+
 // STOP
 TEST(CPU_MISC, STOP) {
     uint8_t opcode = 0x10;
@@ -37,6 +37,25 @@ TEST(CPURegisters, WriteValid16BitRegister) {
     EXPECT_EQ(data, cpu_registers.read_register(REG_BC));
 }
 
+TEST(CPURegisters, RegisterPairAliasing) {
+    CPURegisters cpu_registers;
+
+    cpu_registers.write_register(REG_HL, 0xABCD);
+    EXPECT_EQ(0xAB, cpu_registers.read_register(REG_H));
+    EXPECT_EQ(0xCD, cpu_registers.read_register(REG_L));
+
+    cpu_registers.write_register(REG_D, 0x12);
+    cpu_registers.write_register(REG_E, 0x34);
+    EXPECT_EQ(0x1234, cpu_registers.read_register(REG_DE));
+
+    cpu_registers.write_register(REG_AF, 0x56FF);
+    EXPECT_EQ(0x56, cpu_registers.read_A());
+    EXPECT_EQ(0xF0, cpu_registers.read_F());
+
+    cpu_registers.write_A(0x78);
+    EXPECT_EQ(0x78F0, cpu_registers.read_register(REG_AF));
+}
+
 TEST(CPURegisters, Write8BitRegisterInvalidData) {
     CPURegisters cpu_registers;
 
@@ -152,4 +152,39 @@ TEST(CPU, WriteMemory) {
     cpu.write_memory(REG_BC, val);
 
     EXPECT_EQ(val, cpu.read_memory(REG_BC));
-}
\ No newline at end of file
+}
+
+TEST(CPU, TraceInstructions) {
+    MemoryMap mem_map;
+    CPU cpu(mem_map);
+
+    // LD A, 0x12; NOP
+    mem_map.write(0xC000, 0x3E);
+    mem_map.write(0xC001, 0x12);
+    mem_map.write(0xC002, 0x00);
+    cpu.write_register(REG_PC, 0xC000);
+
+    std::string trace_file = "cpu_trace_test.gbt";
+    trace_logger.open(trace_file);
+    cpu.tick();
+    cpu.tick();
+    trace_logger.close();
+
+    std::ifstream file(trace_file.c_str(), std::ios::binary);
+    TraceHeader_t header;
+    TraceRecord_t records[2];
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    file.read(reinterpret_cast<char *>(records), sizeof(records));
+    EXPECT_TRUE(file.good());
+    file.close();
+    std::remove(trace_file.c_str());
+
+    EXPECT_EQ(TRACE_VERSION, header.version);
+    EXPECT_EQ(0xC000, records[0].pc);
+    EXPECT_EQ(0x3E, records[0].opcode);
+    EXPECT_EQ(0x12, records[0].operands[0]);
+    EXPECT_EQ("LD A, 12", disassemble(records[0].opcode, records[0].operands[0], records[0].operands[1]));
+    EXPECT_EQ(0xC002, records[1].pc);
+    EXPECT_EQ(0x12, records[1].af >> 8);
+    EXPECT_EQ(8, records[1].cycle);
+}
@@ -100,3 +100,31 @@ TEST(FileParser, GetTitle) {
 
     EXPECT_EQ(title, file_parser.get_rom_name());
 }
+
+TEST(FileParser, ROMFileSharedBanks) {
+    std::string rom_file = "rom_file_test.gb";
+    std::vector<char> contents(ROM_BANK_SIZE + 16, 0);
+    contents[0x100] = 0x12;
+    contents[ROM_BANK_SIZE + 1] = 0x34;
+
+    std::ofstream out(rom_file.c_str(), std::ios::binary);
+    out.write(&contents[0], contents.size());
+    out.close();
+
+    std::shared_ptr<ROMFile> rom = std::make_shared<ROMFile>(rom_file);
+    EXPECT_EQ(contents.size(), rom->get_size());
+    EXPECT_EQ(0x12, rom->get_data()[0x100]);
+
+    // Cartridges on the same image share its banks without copying
+    ROMOnly cartridge_1(rom, 1);
+    ROMOnly cartridge_2(rom, 1);
+    EXPECT_EQ(rom->get_data(), cartridge_1.get_rom_bank(0));
+    EXPECT_EQ(cartridge_1.get_rom_bank(0), cartridge_2.get_rom_bank(0));
+
+    // A truncated image is padded so the last bank is complete
+    ROMOnly padded(rom, 2);
+    EXPECT_EQ(0x34, padded.read(ROM_BANK_SIZE + 1));
+    EXPECT_EQ(0x0, padded.read(2 * ROM_BANK_SIZE - 1));
+
+    std::remove(rom_file.c_str());
+}
@@ -0,0 +1,28 @@
+#include "gtest/gtest.h"
+
+
+// Two frames of cycles at real time take two frame periods, unthrottled never waits
+TEST(FramePacer, WaitsForEmulatedTime) {
+    const uint64_t frame_cycles = FRAME_CLOCKS;
+    FramePacer pacer(FRAME_CLOCKS * GAMEBOY_FRAME_RATE);
+
+    // The first wait only sets the starting point
+    pacer.wait(0);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    pacer.wait(frame_cycles);
+    pacer.wait(2 * frame_cycles);
+    int64_t elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    // 2 / 59.73 Hz is 33.5 ms
+    EXPECT_GE(elapsed_ms, 32);
+    EXPECT_GE(pacer.get_average_drift_ns(), 0);
+    EXPECT_EQ(0, pacer.get_resync_count());
+
+    pacer.set_speed(PACER_UNTHROTTLED);
+    start = std::chrono::steady_clock::now();
+    pacer.wait(100 * frame_cycles);
+    elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_LT(elapsed_ms, 10);
+}
@@ -58,4 +58,31 @@ TEST(FrameBuffer, ResetFrameBuffer) {
             EXPECT_EQ(WHITE, buffer.get_pixel(x, y));
         }
     }
+}
+
+
+TEST(FrameBuffer, RowsAndRGBA) {
+    FrameBuffer buffer(LCD_WIDTH, LCD_HEIGHT);
+    EXPECT_EQ(nullptr, buffer.get_rgba());
+
+    uint8_t *row = buffer.get_row(3);
+    row[0] = BLACK;
+    row[LCD_WIDTH - 1] = LIGHT_GRAY;
+
+    EXPECT_EQ(BLACK, buffer.get_pixel(0, 3));
+    EXPECT_EQ(LIGHT_GRAY, buffer.get_pixel(LCD_WIDTH - 1, 3));
+    EXPECT_EQ(WHITE, buffer.get_pixel(0, 4));
+
+    buffer.set_rgba_enabled(true);
+
+    const uint8_t *rgba = buffer.get_rgba() + 3 * LCD_WIDTH * RGBA_PIXEL_BYTES;
+    EXPECT_EQ(0, rgba[0]);
+    EXPECT_EQ(255, rgba[3]);
+    EXPECT_EQ(170, rgba[(LCD_WIDTH - 1) * RGBA_PIXEL_BYTES]);
+    EXPECT_EQ(255, rgba[LCD_WIDTH * RGBA_PIXEL_BYTES]);
+
+    buffer.reset();
+    buffer.update_rgba();
+    EXPECT_EQ(WHITE, buffer.get_pixel(0, 3));
+    EXPECT_EQ(255, rgba[0]);
 }
\ No newline at end of file
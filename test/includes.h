@@ -16,10 +16,21 @@
 #include "video/sprite.h"
 #include "user_interface/user_interface_sfml.h"
 #include "debugger/logger.h"
+#include "debugger/trace_logger.h"
+#include "debugger/disassembler.h"
+#include "scheduler/scheduler.h"
+#include "timer/timer.h"
+#include "movie/movie.h"
+#include "utils/frame_pacer.h"
+#include "utils/rewind_buffer.h"
+#include "utils/triple_buffer.h"
 #include "gameboy.h"
 
 #include <stdio.h>
 #include <iostream>
+#include <fstream>
+#include <map>
+#include <vector>
 
 #ifdef _WIN32
 #include <direct.h>
@@ -59,4 +70,26 @@ std::string get_test_rom() {
     }
 
     return project_dir + TEST_ROM;
-}
\ No newline at end of file
+}
+
+
+// Write a 4 bank MBC1 ROM for tests that need a program to run. Each switchable bank
+// starts with its own number and each entry of code is copied to its address in bank 0.
+void write_test_rom(const std::string &file_name, const std::string &title, const std::map<uint16_t, std::vector<uint8_t>> &code) {
+    std::vector<char> rom(4 * ROM_BANK_SIZE, 0);
+
+    for (int bank = 1; bank < 4; bank++) {
+        rom[bank * ROM_BANK_SIZE] = bank;
+    }
+
+    for (const std::pair<const uint16_t, std::vector<uint8_t>> &block : code) {
+        std::copy(block.second.begin(), block.second.end(), rom.begin() + block.first);
+    }
+
+    std::copy(title.begin(), title.end(), rom.begin() + 0x134);
+    rom[0x147] = ROM_MBC1;
+    rom[0x148] = 0x01;
+
+    std::ofstream file(file_name.c_str(), std::ios::binary);
+    file.write(rom.data(), rom.size());
+}
@@ -20,6 +20,12 @@
 #include "integration_tests.h"
 #include "user_interface_tests.h"
 #include "cartridge_tests.h"
+#include "scheduler_tests.h"
+#include "timer_tests.h"
+#include "frame_pacer_tests.h"
+#include "triple_buffer_tests.h"
+#include "save_state_tests.h"
+#include "movie_tests.h"
 
 
 int main(int argc, char** argv) {
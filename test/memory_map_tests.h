@@ -72,6 +72,34 @@ TEST(MemoryMap, LoadRom) {
     delete cartridge;
 }
 
+TEST(MemoryMap, SwitchRomBank) {
+    int num_banks = 4;
+
+    std::vector<char> contents;
+    contents.resize(num_banks * ROM_BANK_SIZE);
+    std::fill(contents.begin(), contents.end(), 0);
+
+    for (int i = 0; i < num_banks; i++) {
+        contents[i * ROM_BANK_SIZE] = i;
+    }
+
+    MBC1 *cartridge = new MBC1(contents, num_banks);
+
+    MemoryMap mem_map;
+    EXPECT_NO_THROW(mem_map.load_rom(cartridge));
+
+    EXPECT_EQ(0, mem_map.read(0x0000));
+    EXPECT_EQ(1, mem_map.read(0x4000));
+
+    // Select ROM bank 3
+    mem_map.write(0x2000, 0x03);
+
+    EXPECT_EQ(0, mem_map.read(0x0000));
+    EXPECT_EQ(3, mem_map.read(0x4000));
+
+    delete cartridge;
+}
+
 TEST(MemoryMap, WriteToRom) {
     std::vector<char> contents;
     contents.resize(BUFFER_SIZE);
@@ -137,6 +165,25 @@ TEST(MemoryMap, WriteEchoRAM) {
 }
 
 
+TEST(MemoryMap, CopyArena) {
+    MemoryMap mem_map;
+
+    mem_map.write(0xC100, 0xAB);
+    mem_map.write(0xFF90, 0xCD);
+
+    MemoryMap copy(mem_map);
+    mem_map.write(0xC100, 0x12);
+
+    EXPECT_EQ(0xAB, copy.read(0xC100));
+    EXPECT_EQ(0xCD, copy.read(0xFF90));
+    EXPECT_EQ(0xAB, copy.read(0xE100));
+
+    // Restore the original from the copy with a single memcpy
+    std::memcpy(mem_map.get_arena(), copy.get_arena(), ARENA_SIZE);
+    EXPECT_EQ(0xAB, mem_map.read(0xC100));
+}
+
+
 TEST(MemoryMap, IncrementIOCounter) {
     MemoryMap mem_map;
 
@@ -145,4 +192,30 @@ TEST(MemoryMap, IncrementIOCounter) {
     mem_map.increment_io_counter(DIV);
 
     EXPECT_EQ(0x1, mem_map.read(DIV));
-}
\ No newline at end of file
+}
+
+
+class CountingIOListener : public IOListener {
+    public:
+        int reads = 0;
+
+        void io_read(IORegisters_t) override { reads++; }
+        void io_written(IORegisters_t, uint8_t) override {}
+};
+
+TEST(MemoryMap, PeekIONotifiesNoListener) {
+    MemoryMap mem_map;
+    CountingIOListener listener;
+
+    mem_map.set_io_listener(TIMA, &listener);
+    mem_map.set_io_register(TIMA, 0x42);
+
+    EXPECT_EQ(0x42, mem_map.peek(TIMA));
+    EXPECT_EQ(0, listener.reads);
+
+    EXPECT_EQ(0x42, mem_map.read(TIMA));
+    EXPECT_EQ(1, listener.reads);
+
+    mem_map.write(0xC000, 0x12);
+    EXPECT_EQ(0x12, mem_map.peek(0xC000));
+}
@@ -21,6 +21,8 @@ TEST(Memory, WriteValid) {
     EXPECT_EQ(data, mem.read_memory(address));
 }
 
+// Out of range accesses are only detected in builds with bounds checks
+#ifdef MEMORY_BOUNDS_CHECKS
 TEST(Memory, WriteInvalidAddress) {
     int mem_size = 1024;
     uint16_t address = 0xFFFF;
@@ -31,6 +33,7 @@ TEST(Memory, WriteInvalidAddress) {
     EXPECT_TRUE(mem.init_memory());
     EXPECT_ANY_THROW(mem.write_memory(address, data));
 }
+#endif
 
 TEST(Memory, WriteFirstAddress) {
     int mem_size = 1024;
@@ -46,7 +49,7 @@ TEST(Memory, WriteFirstAddress) {
 
 TEST(Memory, WriteLastAddress) {
     int mem_size = 1024;
-    uint16_t address = mem_size;
+    uint16_t address = mem_size - 1;
     uint8_t data = 0x12;
 
     Memory mem(mem_size);
@@ -56,9 +59,21 @@ TEST(Memory, WriteLastAddress) {
     EXPECT_EQ(data, mem.read_memory(address));
 }
 
-TEST(Memory, ReadInvalidAddress) {
+#ifdef MEMORY_BOUNDS_CHECKS
+TEST(Memory, WritePastLastAddress) {
     int mem_size = 1024;
     uint16_t address = mem_size;
+    uint8_t data = 0x12;
+
+    Memory mem(mem_size);
+
+    EXPECT_TRUE(mem.init_memory());
+    EXPECT_ANY_THROW(mem.write_memory(address, data));
+}
+
+TEST(Memory, ReadInvalidAddress) {
+    int mem_size = 1024;
+    uint16_t address = mem_size - 1;
     uint16_t read_address = 0xFFFF;
     uint8_t data = 0x12;
 
@@ -68,3 +83,4 @@ TEST(Memory, ReadInvalidAddress) {
     EXPECT_NO_THROW(mem.write_memory(address, data));
     EXPECT_ANY_THROW(mem.read_memory(read_address));
 }
+#endif
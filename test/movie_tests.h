@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+
+
+// A replayed movie applies each button change at the recorded cycle and ends in the same state.
+// The ROM logs every change it sees on P1 with the number of polls so far, so a press applied
+// at the wrong point of emulation leaves a different log in RAM.
+TEST(Movie, ReplayMatchesRecording) {
+    const std::string rom_file = "movie_test.gb";
+    const std::string movie_file = "test_movie.gbm";
+    std::vector<uint8_t> expected;
+
+    std::map<uint16_t, std::vector<uint8_t>> code;
+    code[0x100] = {0xC3, 0x50, 0x01};                       // JP 0x0150
+    code[0x150] = {
+        0xF3,                                               // DI
+        0x3E, 0x10, 0xE0, 0x00,                             // P1 = select the A, B, SELECT and START buttons
+        0x21, 0x00, 0xC0,                                   // LD HL, 0xC000
+        0x11, 0x00, 0x00, 0x06, 0x00,                       // LD DE, 0x0000; LD B, 0x00
+        0x13, 0xF0, 0x00, 0xB8, 0x28, 0xFA,                 // INC DE; LDH A, (P1); CP B; JR Z, -6
+        0x47, 0x22, 0x7B, 0x22, 0x7A, 0x22,                 // LD B, A; (HL+) = A, E, D
+        0x18, 0xF2                                          // JR -14
+    };
+    write_test_rom(rom_file, "MOVIETEST", code);
+
+    {
+        GameBoy gb(false, true);
+        gb.load_rom(rom_file);
+        while (gb.get_frame_count() < 2) {
+            gb.tick();
+        }
+
+        gb.start_recording();
+        EXPECT_EQ(MOVIE_RECORDING, gb.get_movie_mode());
+
+        for (uint64_t frame = 3; frame <= 8; frame++) {
+            while (gb.get_frame_count() < frame) {
+                gb.tick();
+            }
+
+            // Part way into the frame, at a different point each time
+            for (uint64_t i = 0; i < frame * 7; i++) {
+                gb.tick();
+            }
+
+            gb.set_button_pressed((frame % 2) ? START : A, frame < 6);
+        }
+
+        expected = gb.save_state();
+        gb.stop_recording(movie_file);
+        EXPECT_EQ(MOVIE_OFF, gb.get_movie_mode());
+    }
+
+    GameBoy gb(false, true);
+    gb.load_rom(rom_file);
+    gb.start_replay(movie_file);
+    EXPECT_EQ(2, gb.get_frame_count());
+
+    while (!gb.is_replay_finished()) {
+        gb.tick();
+    }
+
+    EXPECT_EQ(8, gb.get_frame_count());
+    EXPECT_EQ(expected, gb.save_state());
+
+    std::remove(rom_file.c_str());
+    std::remove(movie_file.c_str());
+}
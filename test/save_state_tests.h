@@ -0,0 +1,124 @@
+#include "gtest/gtest.h"
+
+
+// MBC1 program that keeps the timer overflowing into interrupts, switches ROM bank
+// every VBlank and copies from the current bank into VRAM and OAM in between
+std::string write_save_state_test_rom() {
+    std::map<uint16_t, std::vector<uint8_t>> code;
+
+    code[0x40] = {0xC3, 0x70, 0x00};            // VBlank: JP 0x0070
+    code[0x50] = {0x14, 0xD9};                  // Timer: INC D; RETI
+    code[0x70] = {
+        0xF5,                                   // PUSH AF
+        0x1C, 0x7B, 0xE6, 0x03,                 // INC E; LD A, E; AND 0x03
+        0xEA, 0x00, 0x20,                       // LD (0x2000), A, select ROM bank
+        0xF1, 0xD9                              // POP AF; RETI
+    };
+    code[0x100] = {0xC3, 0x50, 0x01};           // JP 0x0150
+    code[0x150] = {
+        0x3E, 0x05, 0xE0, 0xFF,                 // IE = VBlank | timer
+        0x3E, 0xF0, 0xE0, 0x06,                 // TMA = 0xF0
+        0x3E, 0x05, 0xE0, 0x07,                 // TAC = enabled, fastest clock
+        0x21, 0x00, 0x80,                       // LD HL, 0x8000
+        0xFB,                                   // EI
+        0x0C,                                   // loop: INC C
+        0xFA, 0x00, 0x40, 0x22,                 // LD A, (0x4000); LD (HL+), A
+        0x79, 0xEA, 0x10, 0xFE,                 // LD A, C; LD (0xFE10), A
+        0x7C, 0xFE, 0x98,                       // LD A, H; CP 0x98
+        0x20, 0x02, 0x26, 0x80,                 // JR NZ, +2; LD H, 0x80
+        0x76,                                   // HALT
+        0x18, 0xED                              // JR loop
+    };
+
+    std::string rom_file = "save_state_test.gb";
+    write_test_rom(rom_file, "SAVESTATE", code);
+
+    return rom_file;
+}
+
+// Running on from a loaded state ends in the same state as running straight through
+TEST(SaveState, RestoredRunMatches) {
+    std::string rom_file = write_save_state_test_rom();
+    std::vector<std::vector<uint8_t>> states;
+    std::vector<uint8_t> expected;
+
+    {
+        GameBoy gb(false, true);
+        gb.load_rom(rom_file);
+        while (gb.get_frame_count() < 3) {
+            gb.tick();
+        }
+
+        // Part way into the frame, each tick ends at a PPU mode change or a timer
+        // overflow, so the states cover pending interrupts, reloads and HALT
+        for (int i = 0; i < 1000; i++) {
+            gb.tick();
+        }
+        for (int i = 0; i < 8; i++) {
+            states.push_back(gb.save_state());
+            gb.tick();
+        }
+
+        while (gb.get_frame_count() < 6) {
+            gb.tick();
+        }
+
+        expected = gb.save_state();
+    }
+
+    for (const std::vector<uint8_t> &state : states) {
+        GameBoy gb(false, true);
+        gb.load_rom(rom_file);
+        gb.load_state(state);
+        EXPECT_EQ(3, gb.get_frame_count());
+
+        while (gb.get_frame_count() < 6) {
+            gb.tick();
+        }
+
+        EXPECT_EQ(expected, gb.save_state());
+    }
+
+    std::remove(rom_file.c_str());
+}
+
+TEST(SaveState, RejectsInvalidState) {
+    GameBoy gb(false, true);
+    std::vector<uint8_t> state = gb.save_state();
+
+    std::vector<uint8_t> truncated(state.begin(), state.end() - 1);
+    EXPECT_ANY_THROW(gb.load_state(truncated));
+
+    std::vector<uint8_t> wrong_version = state;
+    wrong_version[sizeof(SAVE_STATE_MAGIC)]++;
+    EXPECT_ANY_THROW(gb.load_state(wrong_version));
+}
+
+// Snapshots come back newest first and unchanged, the oldest are dropped past the limit
+TEST(SaveState, RewindBufferRoundTrip) {
+    const size_t max_snapshots = 3;
+    RewindBuffer rewind(max_snapshots, 1024 * 1024);
+
+    std::vector<std::vector<uint8_t>> snapshots;
+    std::srand(1);
+    std::vector<uint8_t> state(1000, 0);
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 50; j++) {
+            state[std::rand() % state.size()] = std::rand();
+        }
+        snapshots.push_back(state);
+
+        std::vector<uint8_t> pushed = state;
+        rewind.push(pushed);
+    }
+
+    EXPECT_EQ(max_snapshots, rewind.get_num_snapshots());
+
+    std::vector<uint8_t> popped;
+    for (int i = 3; i > 0; i--) {
+        EXPECT_TRUE(rewind.pop(popped));
+        EXPECT_EQ(snapshots[i], popped);
+    }
+
+    EXPECT_FALSE(rewind.pop(popped));
+}
@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+
+
+class SchedulerTestHandler : public EventHandler {
+    public:
+        void handle_event(EventType_t type, uint64_t cycles) override {
+            events.push_back(type);
+            times.push_back(cycles);
+        }
+
+        std::vector<EventType_t> events;
+        std::vector<uint64_t> times;
+};
+
+
+TEST(Scheduler, RunDueEventsInOrder) {
+    Scheduler scheduler;
+    SchedulerTestHandler handler;
+    scheduler.set_handler(EVENT_VIDEO, &handler);
+    scheduler.set_handler(EVENT_TIMER, &handler);
+
+    scheduler.schedule(EVENT_VIDEO, 100);
+    scheduler.schedule(EVENT_TIMER, 40);
+    EXPECT_EQ(40, scheduler.get_next_event_time());
+
+    // Nothing is due yet
+    scheduler.add_cycles(39);
+    scheduler.run_due_events();
+    EXPECT_EQ(0, handler.events.size());
+
+    // Handlers get the current cycle count, not the deadline
+    scheduler.add_cycles(70);
+    scheduler.run_due_events();
+    ASSERT_EQ(2, handler.events.size());
+    EXPECT_EQ(EVENT_TIMER, handler.events[0]);
+    EXPECT_EQ(EVENT_VIDEO, handler.events[1]);
+    EXPECT_EQ(109, handler.times[1]);
+    EXPECT_EQ(NO_EVENT, scheduler.get_next_event_time());
+}
+
+
+TEST(Scheduler, RescheduleAndCancel) {
+    Scheduler scheduler;
+    SchedulerTestHandler handler;
+    scheduler.set_handler(EVENT_VIDEO, &handler);
+    scheduler.set_handler(EVENT_TIMER, &handler);
+
+    // Scheduling again replaces the earlier deadline
+    scheduler.schedule(EVENT_VIDEO, 10);
+    scheduler.schedule(EVENT_VIDEO, 50);
+    EXPECT_EQ(50, scheduler.get_next_event_time());
+
+    scheduler.schedule(EVENT_TIMER, 20);
+    scheduler.cancel(EVENT_TIMER);
+    EXPECT_EQ(NO_EVENT, scheduler.get_deadline(EVENT_TIMER));
+
+    scheduler.add_cycles(60);
+    scheduler.run_due_events();
+    ASSERT_EQ(1, handler.events.size());
+    EXPECT_EQ(EVENT_VIDEO, handler.events[0]);
+
+    // Many replaced deadlines do not grow the heap without bound
+    for (int i = 0; i < 1000; i++) {
+        scheduler.schedule(EVENT_TIMER, 1000 - i);
+    }
+    EXPECT_EQ(1, scheduler.get_next_event_time());
+}
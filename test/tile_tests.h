@@ -121,6 +121,41 @@ TEST(Tile, GetTileRowFromMemory) {
 }
 
 
+void check_tile_decoder(TileDecoder_t decoder) {
+    // 3 whole tiles plus 3 rows so the vector versions also run their tail
+    const int rows = 3 * TILE_HEIGHT + 3;
+    uint8_t tile_data[2 * rows];
+    for (int i = 0; i < 2 * rows; i++) {
+        tile_data[i] = (uint8_t)(i * 37 + 11);
+    }
+
+    uint8_t pixels[rows * TILE_WIDTH];
+    decoder(tile_data, pixels, rows);
+
+    MemoryMap memory_map;
+    TileRow tile_row(0x8000, memory_map);
+    for (int row = 0; row < rows; row++) {
+        std::vector<PixelColour_t> expected = tile_row.get_tile_row(tile_data[2 * row], tile_data[2 * row + 1]);
+        for (int x = 0; x < TILE_WIDTH; x++) {
+            EXPECT_EQ(expected[x], pixels[row * TILE_WIDTH + x]);
+        }
+    }
+}
+
+TEST(Tile, DecodeTileRows) {
+    check_tile_decoder(decode_tile_rows);
+    check_tile_decoder(decode_tile_rows_portable);
+#ifdef TILE_DECODER_X86
+    if (cpu_supports_sse2()) {
+        check_tile_decoder(decode_tile_rows_sse2);
+    }
+    if (cpu_supports_avx2()) {
+        check_tile_decoder(decode_tile_rows_avx2);
+    }
+#endif
+}
+
+
 TEST(Tile, GetPixelIndexFromTile) {
     uint16_t starting_address = 0x8000;
     // 0  1  2  3  4  5  6  7
@@ -0,0 +1,152 @@
+#include "gtest/gtest.h"
+
+
+TEST(Timer, DIVFollowsCycles) {
+    MemoryMap mem_map;
+    Timer timer(mem_map);
+
+    timer.tick(3 * 256 + 10);
+    EXPECT_EQ(0x3, mem_map.read(DIV));
+
+    // Writing any value resets the whole counter
+    mem_map.write(DIV, 0x55);
+    EXPECT_EQ(0x0, mem_map.read(DIV));
+
+    timer.tick(255);
+    EXPECT_EQ(0x0, mem_map.read(DIV));
+    timer.tick(1);
+    EXPECT_EQ(0x1, mem_map.read(DIV));
+}
+
+
+TEST(Timer, TIMAIncrementsAtSelectedRate) {
+    MemoryMap mem_map;
+    Timer timer(mem_map);
+
+    // Stopped timer does not count
+    timer.tick(1024);
+    EXPECT_EQ(0x0, mem_map.read(TIMA));
+
+    // 16 cycles per increment
+    mem_map.write(TAC, 0x05);
+    timer.tick(16 * 10 + 15);
+    EXPECT_EQ(10, mem_map.read(TIMA));
+
+    // 1024 cycles per increment
+    mem_map.write(TAC, 0x04);
+    mem_map.write(DIV, 0x0);
+    mem_map.write(TIMA, 0x0);
+    timer.tick(1023);
+    EXPECT_EQ(0, mem_map.read(TIMA));
+    timer.tick(1);
+    EXPECT_EQ(1, mem_map.read(TIMA));
+}
+
+
+TEST(Timer, OverflowReloadsTMAAfterDelay) {
+    MemoryMap mem_map;
+    Timer timer(mem_map);
+    mem_map.write(IF, 0x0);
+
+    mem_map.write(TMA, 0xF0);
+    mem_map.write(TIMA, 0xFF);
+    mem_map.write(TAC, 0x05);
+
+    // TIMA reads 0 until the reload
+    timer.tick(16);
+    EXPECT_EQ(0x0, mem_map.read(TIMA));
+    EXPECT_FALSE(mem_map.get_interrupt_flag_bit(TIMER));
+
+    timer.tick(TIMER_RELOAD_DELAY);
+    EXPECT_EQ(0xF0, mem_map.read(TIMA));
+    EXPECT_TRUE(mem_map.get_interrupt_flag_bit(TIMER));
+}
+
+
+TEST(Timer, ScheduledOverflow) {
+    MemoryMap mem_map;
+    Scheduler scheduler;
+    Timer timer(mem_map);
+    timer.set_scheduler(&scheduler);
+    mem_map.write(IF, 0x0);
+
+    // Nothing is scheduled while the timer is stopped
+    EXPECT_EQ(NO_EVENT, scheduler.get_next_event_time());
+
+    mem_map.write(TIMA, 0xFE);
+    mem_map.write(TAC, 0x06);
+    EXPECT_EQ(2 * 64, scheduler.get_next_event_time());
+
+    scheduler.add_cycles(2 * 64);
+    scheduler.run_due_events();
+    EXPECT_EQ(2 * 64 + TIMER_RELOAD_DELAY, scheduler.get_next_event_time());
+
+    scheduler.add_cycles(TIMER_RELOAD_DELAY);
+    scheduler.run_due_events();
+    EXPECT_TRUE(mem_map.get_interrupt_flag_bit(TIMER));
+    EXPECT_EQ(0x0, mem_map.read(TIMA));
+}
+
+// Arm a timer overflow two increments away, then run wait. The timer handler and wait
+// both store the first TIMA read after the overflow to 0xC000, which is returned.
+uint8_t read_tima_after_armed_overflow(const std::vector<uint8_t> &wait) {
+    std::map<uint16_t, std::vector<uint8_t>> code;
+
+    code[0x50] = {
+        0xF0, 0x05, 0xEA, 0x00, 0xC0,                       // LDH A, (TIMA); LD (0xC000), A
+        0xAF, 0xE0, 0x07, 0xD9                              // Stop the timer, only the first overflow counts; RETI
+    };
+    code[0x100] = {0xC3, 0x50, 0x01};                       // JP 0x0150
+    code[0x150] = {
+        0x3E, 0xFF, 0xEA, 0x00, 0xC0,                       // (0xC000) = 0xFF
+        0x3E, 0x04, 0xE0, 0xFF,                             // IE = timer
+        0x3E, 0xFE, 0xE0, 0x05,                             // TIMA = 0xFE
+        0xAF, 0xE0, 0x06,                                   // TMA = 0x00
+        0x3E, 0x05, 0xE0, 0x07                              // TAC = enabled, fastest clock
+    };
+    code[0x150].insert(code[0x150].end(), wait.begin(), wait.end());
+
+    std::string rom_file = "timer_test.gb";
+    write_test_rom(rom_file, "TIMERTEST", code);
+
+    GameBoy gb(false, true);
+    gb.load_rom(rom_file);
+    while (gb.get_frame_count() < 1) {
+        gb.tick();
+    }
+
+    std::remove(rom_file.c_str());
+
+    return gb.peek(0xC000);
+}
+
+// Arming the timer part way through a tick moves its deadline earlier, the overflow must
+// interrupt on time instead of at the deadline the tick started with. The handler then
+// runs straight after the reload, before TIMA counts up from TMA again.
+TEST(Timer, OverflowArmedMidTickIsServicedOnTime) {
+    // EI; JR -2
+    EXPECT_EQ(0x00, read_tima_after_armed_overflow({0xFB, 0x18, 0xFE}));
+}
+
+// HALT and polling loops are fast-forwarded to the next event, which must be the overflow
+// the CPU just armed and not a later one
+TEST(Timer, WaitAfterArmingEndsAtOverflow) {
+    // EI; HALT; JR -2
+    EXPECT_EQ(0x00, read_tima_after_armed_overflow({0xFB, 0x76, 0x18, 0xFE}));
+
+    // HALT with interrupts disabled wakes without calling the handler
+    EXPECT_EQ(0x00, read_tima_after_armed_overflow({
+        0xF3, 0x76,                                         // DI; HALT
+        0xF0, 0x05, 0xEA, 0x00, 0xC0,                       // LDH A, (TIMA); LD (0xC000), A
+        0x18, 0xFE                                          // JR -2
+    }));
+
+    // Polling IF with interrupts disabled, the flag is seen on the next 32 cycle pass
+    // of the loop, so TIMA has counted up to 3 times by then
+    EXPECT_LE(read_tima_after_armed_overflow({
+        0xF3,                                               // DI
+        0xF0, 0x0F, 0xE6, 0x04, 0x28, 0xFA,                 // LDH A, (IF); AND 0x04; JR Z, -6
+        0xF0, 0x05, 0xEA, 0x00, 0xC0,                       // LDH A, (TIMA); LD (0xC000), A
+        0x18, 0xFE                                          // JR -2
+    }), 0x03);
+}
@@ -0,0 +1,103 @@
+#include "gtest/gtest.h"
+
+#include <array>
+#include <thread>
+
+
+TEST(TripleBuffer, UpdateTakesPublishedItem) {
+    TripleBuffer<int> buffer(0);
+
+    buffer.get_write_buffer() = 1;
+    buffer.publish();
+
+    EXPECT_TRUE(buffer.update());
+    EXPECT_EQ(1, buffer.get_read_buffer());
+}
+
+// The read slot is left as it was when the producer has nothing new
+TEST(TripleBuffer, UpdateWithoutPublish) {
+    TripleBuffer<int> buffer(0);
+
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(0, buffer.get_read_buffer());
+
+    buffer.get_write_buffer() = 1;
+    buffer.publish();
+    EXPECT_TRUE(buffer.update());
+
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(1, buffer.get_read_buffer());
+}
+
+// Items the consumer did not take in time are dropped, only the newest is read
+TEST(TripleBuffer, NewestPublishWins) {
+    TripleBuffer<int> buffer(0);
+
+    buffer.get_write_buffer() = 1;
+    buffer.publish();
+    buffer.get_write_buffer() = 2;
+    buffer.publish();
+
+    EXPECT_TRUE(buffer.update());
+    EXPECT_EQ(2, buffer.get_read_buffer());
+    EXPECT_FALSE(buffer.update());
+}
+
+TEST(TripleBuffer, ReadSlotIsNeverWriteSlot) {
+    TripleBuffer<int> buffer(0);
+
+    for (int i = 1; i < 20; i++) {
+        buffer.get_write_buffer() = i;
+        EXPECT_NE(&buffer.get_read_buffer(), &buffer.get_write_buffer());
+
+        buffer.publish();
+        EXPECT_NE(&buffer.get_read_buffer(), &buffer.get_write_buffer());
+
+        // Read on every third item only, so publishes also land on an unread slot
+        if (i % 3 == 0) {
+            EXPECT_TRUE(buffer.update());
+            EXPECT_EQ(i, buffer.get_read_buffer());
+            EXPECT_NE(&buffer.get_read_buffer(), &buffer.get_write_buffer());
+        }
+    }
+}
+
+// A frame being written while the consumer reads would show up as a mix of two frames
+TEST(TripleBuffer, ConcurrentFramesAreNeverTorn) {
+    typedef std::array<uint32_t, 256> Frame_t;
+    const uint32_t num_frames = 100000;
+
+    Frame_t initial;
+    initial.fill(0);
+    TripleBuffer<Frame_t> buffer(initial);
+
+    std::thread producer([&buffer, num_frames]() {
+        for (uint32_t frame = 1; frame <= num_frames; frame++) {
+            buffer.get_write_buffer().fill(frame);
+            buffer.publish();
+        }
+    });
+
+    uint32_t last_frame = 0;
+    bool torn = false;
+    bool out_of_order = false;
+    while (last_frame < num_frames && !torn && !out_of_order) {
+        if (!buffer.update()) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const Frame_t &frame = buffer.get_read_buffer();
+        for (uint32_t value : frame) {
+            torn |= value != frame[0];
+        }
+        out_of_order |= frame[0] <= last_frame;
+        last_frame = frame[0];
+    }
+
+    producer.join();
+
+    EXPECT_FALSE(torn);
+    EXPECT_FALSE(out_of_order);
+    EXPECT_EQ(num_frames, last_frame);
+}
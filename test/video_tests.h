@@ -283,6 +283,26 @@ TEST(Video, GetScrollX) {
 }
 
 
+TEST(Video, CoincidenceFlagUpdatedOnLYCWrite) {
+    MemoryMap mem_map;
+    UI_SFML ui(mem_map);
+    Video video(mem_map, ui);
+
+    // No tick is needed, the flag follows writes to LYC and LY
+    mem_map.write(LYC, 5);
+    EXPECT_FALSE(video.get_coincidence_flag());
+
+    for (int i = 0; i < 5; i++) {
+        mem_map.increment_io_counter(LY);
+    }
+    mem_map.write(LYC, 5);
+    EXPECT_TRUE(video.get_coincidence_flag());
+
+    mem_map.write(LY, 0);
+    EXPECT_FALSE(video.get_coincidence_flag());
+}
+
+
 TEST(Video, GetLY) {
     MemoryMap mem_map;
     UI_SFML ui(mem_map);
@@ -559,6 +579,31 @@ TEST(Video, TestVideoModeTiming) {
 }
 
 
+TEST(Video, HeadlessFrameTiming) {
+    MemoryMap mem_map;
+    UI_SFML ui(mem_map, true);
+    Video video(mem_map, ui, true);
+    ui.init_display("TEST");
+
+    video.write_io_register(LCDC, 0x91);
+    video.set_video_mode(HBLANK_Mode);
+    video.write_io_register(IF, 0x0);
+
+    // Headless mode still advances LY and raises V-Blank
+    while (video.get_line() < 144) {
+        video.tick(4);
+    }
+    EXPECT_EQ(VBLANK_Mode, video.get_video_mode());
+    EXPECT_EQ(0x01, video.read_io_register(IF) & 0x01);
+    EXPECT_EQ(0, (int)video.get_frame_count());
+
+    while (video.get_line() != 0) {
+        video.tick(4);
+    }
+    EXPECT_EQ(1, (int)video.get_frame_count());
+}
+
+
 TEST(Video, GetRealColourFromPalette) {
     // LIGHT GRAY, BLACK, WHITE, DARK GRAY
     uint8_t bgp = 0x72; // 0111 0010
@@ -585,10 +630,126 @@ TEST(Video, GetBuffer) {
     Video video(mem_map, ui);
 
     FrameBuffer buffer = video.get_buffer();
+    EXPECT_EQ(LCD_WIDTH, buffer.get_width());
+    EXPECT_EQ(LCD_HEIGHT, buffer.get_height());
 
-    for (int x = 0; x < MAP_SIZE; x++) {
-        for (int y = 0; y < MAP_SIZE; y++) {
+    for (int x = 0; x < LCD_WIDTH; x++) {
+        for (int y = 0; y < LCD_HEIGHT; y++) {
             EXPECT_EQ(WHITE, buffer.get_pixel(x, y));
         }
     }
 }
+
+
+TEST(Video, DrawBackgroundLineFromTileCache) {
+    MemoryMap mem_map;
+    UI_SFML ui(mem_map);
+    Video video(mem_map, ui);
+
+    // Identity palette, unsigned tile data, tile map 0
+    video.write_io_register(BGP, 0xE4);
+    video.write_io_register(LCDC, 0x91);
+
+    // Tile 1 row 2 is 0, 0, 1, 1, 2, 2, 3, 3
+    mem_map.write(0x8000 + TILE_BYTE_LENGTH + 4, 0x33);
+    mem_map.write(0x8000 + TILE_BYTE_LENGTH + 5, 0x0F);
+    mem_map.write(TILE_MAP_0 + 1, 0x01);
+
+    // Scroll 4 pixels so the tile starts part way into a tile column
+    video.write_io_register(SCX, 4);
+    video.draw_background_line(2);
+
+    FrameBuffer &buffer = video.get_buffer();
+    EXPECT_EQ(WHITE, buffer.get_pixel(3, 2));
+    EXPECT_EQ(WHITE, buffer.get_pixel(5, 2));
+    EXPECT_EQ(LIGHT_GRAY, buffer.get_pixel(6, 2));
+    EXPECT_EQ(DARK_GRAY, buffer.get_pixel(8, 2));
+    EXPECT_EQ(BLACK, buffer.get_pixel(11, 2));
+    EXPECT_EQ(WHITE, buffer.get_pixel(12, 2));
+}
+
+TEST(Video, PaletteCacheUpdatedOnWrite) {
+    MemoryMap mem_map;
+
+    // Power on values, BGP = 0xFC
+    EXPECT_EQ(WHITE, mem_map.get_palette_cache().get_background()[Colour0]);
+    EXPECT_EQ(BLACK, mem_map.get_palette_cache().get_background()[Colour1]);
+
+    mem_map.write(BGP, 0x1B);
+    mem_map.write(OBP1, 0xE4);
+
+    const Colour_t *background = mem_map.get_palette_cache().get_background();
+    EXPECT_EQ(BLACK, background[Colour0]);
+    EXPECT_EQ(DARK_GRAY, background[Colour1]);
+    EXPECT_EQ(LIGHT_GRAY, background[Colour2]);
+    EXPECT_EQ(WHITE, background[Colour3]);
+
+    // Copies decode the palettes from the copied registers
+    MemoryMap copy(mem_map);
+    EXPECT_EQ(BLACK, copy.get_palette_cache().get_background()[Colour0]);
+    EXPECT_EQ(BLACK, copy.get_palette_cache().get_sprite(OBJECT_PALETTE_1)[Colour3]);
+    EXPECT_EQ(BLACK, copy.get_palette_cache().get_sprite(OBJECT_PALETTE_0)[Colour3]);
+}
+
+
+/* Sprites */
+TEST(Video, DrawSpriteLineLimit) {
+    MemoryMap mem_map;
+    UI_SFML ui(mem_map);
+    Video video(mem_map, ui);
+
+    video.write_io_register(BGP, 0xE4);
+    video.write_io_register(OBP0, 0xE4);
+    video.write_io_register(LCDC, 0x93);
+
+    // Tile 1 is black on every row
+    for (int i = 0; i < TILE_BYTE_LENGTH; i++) {
+        mem_map.write(0x8000 + TILE_BYTE_LENGTH + i, 0xFF);
+    }
+
+    // 11 sprites side by side on lines 0-7, only the first 10 in OAM are drawn
+    for (int i = 0; i < MAX_SPRITES_PER_LINE + 1; i++) {
+        mem_map.write(0xFE00 + i * SPRITE_BYTES, 16);
+        mem_map.write(0xFE00 + i * SPRITE_BYTES + 1, 8 + i * TILE_WIDTH);
+        mem_map.write(0xFE00 + i * SPRITE_BYTES + 2, 1);
+    }
+
+    video.write_scanline(0);
+
+    FrameBuffer &buffer = video.get_buffer();
+    EXPECT_EQ(BLACK, buffer.get_pixel(0, 0));
+    EXPECT_EQ(BLACK, buffer.get_pixel(79, 0));
+    EXPECT_EQ(WHITE, buffer.get_pixel(80, 0));
+    EXPECT_EQ(WHITE, buffer.get_pixel(87, 0));
+}
+
+TEST(Video, DrawSpriteLine8x16) {
+    MemoryMap mem_map;
+    UI_SFML ui(mem_map);
+    Video video(mem_map, ui);
+
+    video.write_io_register(OBP0, 0xE4);
+    video.write_io_register(LCDC, 0x97);
+
+    // Tile 3 row 0 is 1, 1, 1, 1, 3, 3, 3, 3
+    mem_map.write(0x8000 + 3 * TILE_BYTE_LENGTH, 0xFF);
+    mem_map.write(0x8000 + 3 * TILE_BYTE_LENGTH + 1, 0x0F);
+
+    // Odd tile numbers are rounded down, line 8 is the first row of the second tile
+    mem_map.write(0xFE00, 16);
+    mem_map.write(0xFE01, 8);
+    mem_map.write(0xFE02, 3);
+
+    video.write_scanline(8);
+
+    FrameBuffer &buffer = video.get_buffer();
+    EXPECT_EQ(LIGHT_GRAY, buffer.get_pixel(0, 8));
+    EXPECT_EQ(BLACK, buffer.get_pixel(4, 8));
+
+    // X flip
+    mem_map.write(0xFE03, SPRITE_X_FLIP);
+    video.write_scanline(8);
+
+    EXPECT_EQ(BLACK, buffer.get_pixel(0, 8));
+    EXPECT_EQ(LIGHT_GRAY, buffer.get_pixel(7, 8));
+}